@@ -0,0 +1,105 @@
+#include "Arduino.h"
+#include "ButtonScanner.h"
+
+
+/**
+ * \brief Sets the pin of a button to input mode. All buttons have to be on the same port.
+ * \param button	The index of the button.
+ * \param pin		The digital pin value on the arduino.
+ * \return true = assigned, false = the pin is on another port than the previous buttons
+ */
+boolean ButtonScanner::assignButton(const uint8_t button, const uint8_t pin)
+{
+	volatile uint8_t *inputRegister = portInputRegister(digitalPinToPort(pin));
+
+	if(_inputRegister != nullptr && _inputRegister != inputRegister)
+	{
+		return false;
+	}
+
+	pinMode(pin, INPUT);
+	_inputRegister = inputRegister;
+	_bitMasks[button] = digitalPinToBitMask(pin);
+	_portMask |= _bitMasks[button];
+	return true;
+}
+
+
+/**
+ * \brief Samples all buttons at once and updates the debounced states. Has to be called at a fixed rate.
+ */
+void ButtonScanner::scan()
+{
+	if(_inputRegister == nullptr)
+	{
+		return;
+	}
+
+	const uint8_t sample = *_inputRegister & _portMask;
+	uint8_t changes = _state ^ sample;
+
+	// two bit vertical counter per port bit, reset by every sample that equals the debounced state
+	_counter0 = ~(_counter0 & changes);
+	_counter1 = _counter0 ^ (_counter1 & changes);
+	changes &= _counter0 & _counter1;
+
+	_state ^= changes;
+	_pressedEvents |= _state & changes;
+	_releasedEvents |= ~_state & changes;
+}
+
+
+/**
+ * \brief The buttons that were pressed since the last call.
+ * \return One bit per button index, 1 = pressed
+ */
+uint8_t ButtonScanner::takePressedButtons()
+{
+	const uint8_t events = _pressedEvents;
+	_pressedEvents = 0;
+	return convertToButtons(events);
+}
+
+
+/**
+ * \brief The buttons that were released since the last call.
+ * \return One bit per button index, 1 = released
+ */
+uint8_t ButtonScanner::takeReleasedButtons()
+{
+	const uint8_t events = _releasedEvents;
+	_releasedEvents = 0;
+	return convertToButtons(events);
+}
+
+
+/**
+ * \brief Indicates whether the debounced button is pressed.
+ * \param button	The index of the button.
+ * \return true = pressed
+ */
+boolean ButtonScanner::isButtonPressed(const uint8_t button) const
+{
+	return (_state & _bitMasks[button]) != 0;
+}
+
+
+uint8_t ButtonScanner::convertToButtons(const uint8_t portBits) const
+{
+	if(portBits == 0)
+	{
+		return 0;
+	}
+
+	uint8_t buttons = 0;
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		if(portBits & _bitMasks[i])
+		{
+			buttons |= 1 << i;
+		}
+	}
+
+	return buttons;
+}
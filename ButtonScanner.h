@@ -0,0 +1,40 @@
+#ifndef BUTTON_SCANNER_H
+#define BUTTON_SCANNER_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+
+
+/**
+ * Reads all link selection buttons with a single port access and debounces them with a vertical counter:
+ * a button changes its state only after four equal samples in a row.
+ */
+class ButtonScanner
+{
+public:
+	/* Methods */
+	boolean assignButton(const uint8_t button, const uint8_t pin);
+	void scan();
+	uint8_t takePressedButtons();
+	uint8_t takeReleasedButtons();
+	boolean isButtonPressed(const uint8_t button) const;
+
+private:
+	/* Variables */
+	volatile uint8_t *_inputRegister = nullptr; // Input register of the port all buttons belong to.
+	uint8_t _bitMasks[NUMBER_OF_LINKS] = {}; // Bit of each button within the port.
+	uint8_t _portMask = 0; // Bits of all assigned buttons.
+	uint8_t _state = 0; // debounced state per port bit, 1 = pressed
+	uint8_t _counter0 = 0xFF; // low bits of the vertical counters
+	uint8_t _counter1 = 0xFF; // high bits of the vertical counters
+	uint8_t _pressedEvents = 0; // port bits that were pressed since the last take
+	uint8_t _releasedEvents = 0; // port bits that were released since the last take
+
+	/* Methods */
+	uint8_t convertToButtons(const uint8_t portBits) const;
+};
+
+static_assert(NUMBER_OF_LINKS <= 8, "the buttons have to fit into a single port");
+
+#endif // BUTTON_SCANNER_H
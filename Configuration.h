@@ -0,0 +1,86 @@
+#ifndef CONFIGURATION_H
+#define CONFIGURATION_H
+
+#include "Arduino.h"
+#include "MotionParameters.h"
+
+
+
+/* Constants */
+constexpr uint8_t NO_PIN = 0xFF;
+constexpr boolean DRIVER_ENABLE_ACTIVE_LOW = true; // the drivers run while their enable input is low
+constexpr uint8_t SERIAL_RX_PIN = 0; // a barrier on a pin of Serial sees the serial traffic as edges
+constexpr uint8_t SERIAL_TX_PIN = 1;
+
+
+/* Types */
+struct TendonConfig
+{
+	uint8_t stepPin;
+	uint8_t directionPin;
+	uint8_t barrierPin;
+};
+
+
+struct LinkConfig
+{
+	TendonConfig up;
+	TendonConfig right;
+	TendonConfig down;
+	TendonConfig left;
+	uint8_t buttonPin; // selects the link
+	uint8_t homingRank; // links with a lower rank are homed first
+	uint8_t enablePin; // shared enable input of the four drivers, NO_PIN = always enabled
+	uint16_t idleTimeout; // milliseconds without movement until the drivers are disabled, 0 = never
+	uint16_t holdTolerance; // the drivers stay enabled while a tendon is further from its center than this
+};
+
+
+/* Configuration */
+// The whole hardware assignment. Adding a row adds a link, everything else is derived from this table.
+// The enable inputs of the drivers are not wired, so the idle power down is off. It needs the enable pin of a link
+// and a timeout, e.g. 2000 ms.
+constexpr LinkConfig LINK_CONFIGS[] = {
+	// 1. oben, rechts, unten, links
+	{ { 28, 26, 21 }, { 45, 43, 20 }, { 33, 31, 19 }, { 37, 35, 18 }, A3, 0, NO_PIN, 0, 20 },
+	// 2.
+	{ { 41, 39, 17 }, { 32, 30, 0 }, { 52, 50, 15 }, { 36, 34, 14 }, A2, 1, NO_PIN, 0, 20 },
+	// 3.
+	{ { 25, 23, 1 }, { 44, 42, 16 }, { 40, 38, 2 }, { 48, 46, 3 }, A1, 2, NO_PIN, 0, 20 },
+	// 4.
+	{ { 49, 47, 4 }, { 53, 51, 5 }, { 29, 27, 6 }, { 24, 22, 7 }, A0, 3, NO_PIN, 0, 20 }
+};
+
+constexpr uint8_t NUMBER_OF_LINKS = sizeof(LINK_CONFIGS) / sizeof(LINK_CONFIGS[0]);
+constexpr uint8_t STEPPERS_PER_LINK = 4;
+constexpr uint8_t NUMBER_OF_STEPPERS = NUMBER_OF_LINKS * STEPPERS_PER_LINK;
+
+// Microsteps per full step as set on the drivers. Positions, limits and speeds stay in full steps, one movement
+// command moves a full step made of this many pulses.
+constexpr uint8_t MICROSTEPS = 1;
+
+// Motors whose step pin is an output compare pin of Timer1, 3, 4 or 5 get hardware timed pulses, the others are
+// stepped in software. Up to 12 are possible, the current wiring has two (pin 45 = OC5B and pin 44 = OC5C).
+constexpr uint8_t MAX_HARDWARE_STEP_CHANNELS = 2;
+
+// Used until parameters are saved to the EEPROM.
+constexpr MotionParameters DEFAULT_MOTION_PARAMETERS = { 250, 500, 1.25, 1600, 750, 2000, 3000, 0, 500 };
+
+// EEPROM layout
+constexpr uint16_t EEPROM_PARAMETERS_ADDRESS = 0;
+constexpr uint16_t EEPROM_TRAJECTORY_ADDRESS = 256;
+
+// Links that are homed at the same time. Fewer links lower the peak motor current, but the homing takes longer.
+constexpr uint8_t MAX_SIMULTANEOUSLY_HOMING_LINKS = NUMBER_OF_LINKS;
+
+constexpr uint8_t JOYSTICK_X_PIN = A8;
+constexpr uint8_t JOYSTICK_Y_PIN = A9;
+
+static_assert(NUMBER_OF_LINKS > 0, "at least one link has to be configured");
+static_assert(MAX_SIMULTANEOUSLY_HOMING_LINKS > 0, "at least one link has to be homed at a time");
+static_assert(MICROSTEPS > 0 && MICROSTEPS <= 32 && (MICROSTEPS & (MICROSTEPS - 1)) == 0,
+	"the microsteps have to be a power of two up to 32");
+static_assert(EEPROM_PARAMETERS_ADDRESS + 4 + NUMBER_OF_LINKS * sizeof(MotionParameters) <= EEPROM_TRAJECTORY_ADDRESS,
+	"the parameters overlap the trajectory in the EEPROM");
+
+#endif // CONFIGURATION_H
@@ -0,0 +1,81 @@
+#include "Arduino.h"
+#include "DriftMonitor.h"
+
+
+/**
+ * \brief Records the error of a barrier edge.
+ * \param error	The counted position minus the expected barrier position in steps.
+ */
+void DriftMonitor::addEdge(const long error)
+{
+	_numberOfEdges++;
+	_lastError = constrain(error, -32768L, 32767L);
+	_maxAbsoluteError = max(_maxAbsoluteError, static_cast<uint16_t>(abs(_lastError)));
+	_errorSum += error;
+}
+
+
+/**
+ * \brief Records that the barrier position was reached but the barrier did not switch, the tendon is behind its
+ *        counted position.
+ */
+void DriftMonitor::addMissingEdge()
+{
+	_numberOfMissingEdges++;
+}
+
+
+/**
+ * \brief Records that the counted position was set back to the barrier position.
+ */
+void DriftMonitor::addCorrection()
+{
+	_numberOfCorrections++;
+}
+
+
+void DriftMonitor::reset()
+{
+	_numberOfEdges = 0;
+	_numberOfMissingEdges = 0;
+	_numberOfCorrections = 0;
+	_lastError = 0;
+	_maxAbsoluteError = 0;
+	_errorSum = 0;
+}
+
+
+uint16_t DriftMonitor::getNumberOfEdges() const
+{
+	return _numberOfEdges;
+}
+
+
+uint16_t DriftMonitor::getNumberOfMissingEdges() const
+{
+	return _numberOfMissingEdges;
+}
+
+
+uint16_t DriftMonitor::getNumberOfCorrections() const
+{
+	return _numberOfCorrections;
+}
+
+
+int16_t DriftMonitor::getLastError() const
+{
+	return _lastError;
+}
+
+
+uint16_t DriftMonitor::getMaxAbsoluteError() const
+{
+	return _maxAbsoluteError;
+}
+
+
+long DriftMonitor::getErrorSum() const
+{
+	return _errorSum;
+}
@@ -0,0 +1,37 @@
+#ifndef DRIFT_MONITOR_H
+#define DRIFT_MONITOR_H
+
+#include "Arduino.h"
+
+
+
+/**
+ * Collects the position errors of a tendon that are found when its limit barrier switches during operation.
+ * The error is the counted position minus the position where the barrier was found during the homing.
+ */
+class DriftMonitor
+{
+public:
+	/* Methods */
+	void addEdge(const long error);
+	void addMissingEdge();
+	void addCorrection();
+	void reset();
+	uint16_t getNumberOfEdges() const;
+	uint16_t getNumberOfMissingEdges() const;
+	uint16_t getNumberOfCorrections() const;
+	int16_t getLastError() const;
+	uint16_t getMaxAbsoluteError() const;
+	long getErrorSum() const;
+
+private:
+	/* Variables */
+	uint16_t _numberOfEdges = 0; // barrier edges that were checked
+	uint16_t _numberOfMissingEdges = 0; // times the barrier position was reached without the barrier
+	uint16_t _numberOfCorrections = 0; // times the position was set back to the barrier position
+	int16_t _lastError = 0; // steps
+	uint16_t _maxAbsoluteError = 0; // steps
+	long _errorSum = 0; // steps, divided by the number of edges it is the mean drift
+};
+
+#endif // DRIFT_MONITOR_H
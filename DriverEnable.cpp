@@ -0,0 +1,77 @@
+#include "Arduino.h"
+#include "DriverEnable.h"
+
+
+/**
+ * \brief Sets the pin to output mode and enables the drivers.
+ * \param pin	The digital pin value on the arduino, NO_PIN if the drivers are always enabled.
+ */
+void DriverEnable::begin(const uint8_t pin)
+{
+	if(pin == NO_PIN)
+	{
+		return;
+	}
+
+	pinMode(pin, OUTPUT);
+	_outputRegister = portOutputRegister(digitalPinToPort(pin));
+	_bitMask = digitalPinToBitMask(pin);
+	_isEnabled = false;
+	enable();
+}
+
+
+/**
+ * \brief Enables the drivers. Costs only a flag check if they are enabled already, so it can be called
+ *        before every step command.
+ */
+void DriverEnable::enable()
+{
+	if(_isEnabled)
+	{
+		return;
+	}
+
+	writePin(!DRIVER_ENABLE_ACTIVE_LOW);
+	_isEnabled = true;
+}
+
+
+/**
+ * \brief Disables the drivers so that the motors are not powered anymore.
+ */
+void DriverEnable::disable()
+{
+	if(!_isEnabled || _outputRegister == nullptr)
+	{
+		return;
+	}
+
+	writePin(DRIVER_ENABLE_ACTIVE_LOW);
+	_isEnabled = false;
+}
+
+
+boolean DriverEnable::isEnabled() const
+{
+	return _isEnabled;
+}
+
+
+void DriverEnable::writePin(const boolean high)
+{
+	// the port is shared with other pins, so the read-modify-write must not be interrupted
+	const uint8_t oldSREG = SREG;
+	cli();
+
+	if(high)
+	{
+		*_outputRegister |= _bitMask;
+	}
+	else
+	{
+		*_outputRegister &= ~_bitMask;
+	}
+
+	SREG = oldSREG;
+}
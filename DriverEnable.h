@@ -0,0 +1,32 @@
+#ifndef DRIVER_ENABLE_H
+#define DRIVER_ENABLE_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+
+
+/**
+ * Switches the shared enable input of the stepper drivers of a link. Without an assigned pin the drivers are
+ * always enabled.
+ */
+class DriverEnable
+{
+public:
+	/* Methods */
+	void begin(const uint8_t pin);
+	void enable();
+	void disable();
+	boolean isEnabled() const;
+
+private:
+	/* Variables */
+	volatile uint8_t *_outputRegister = nullptr; // Output register of the port the assigned pin belongs to.
+	uint8_t _bitMask = 0; // Bit of the assigned pin within the port.
+	boolean _isEnabled = true;
+
+	/* Methods */
+	void writePin(const boolean high);
+};
+
+#endif // DRIVER_ENABLE_H
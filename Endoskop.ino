@@ -1,286 +1,822 @@
 #include "Arduino.h"
+#include "Configuration.h"
 #include "Joystick.h"
-#include "Button.h"
-#include "AccelStepper.h"
-#include "Stepper.h"
-#include "LimitBarrier.h"
+#include "ButtonScanner.h"
+#include "OutputCompareChannels.h"
+#include "MotorTable.h"
 #include "Link.h"
+#include "Trajectory.h"
+#include "MovePlanner.h"
+#include "StackProbe.h"
+#include "Scheduler.h"
+#include "Homing.h"
+#include "Timebase.h"
+#include "ParameterTable.h"
+#include "LatencyMonitor.h"
 
 /* Constants */
-const uint8_t NUMBER_OF_LINKS = 4;
-const uint8_t NUMBER_OF_STEPPERS = NUMBER_OF_LINKS * 4;
+const unsigned long JOYSTICK_PERIOD = 5000; // microseconds, 200 Hz
+const unsigned long BUTTON_PERIOD = 10000; // microseconds, 100 Hz, four equal samples debounce for 40 ms
+const unsigned long SERIAL_COMMAND_PERIOD = 20000; // microseconds, 50 Hz
+const unsigned long TELEMETRY_PERIOD = 50000; // microseconds, 20 Hz
+const unsigned long DRIVER_POWER_PERIOD = 100000; // microseconds, 10 Hz
+const uint8_t COMMAND_LINE_LENGTH = 32; // characters of a parameter command including the terminator
+// first and last button together. A single link has no chord, its button only selects it and 'g' straightens
+const uint8_t STRAIGHTEN_CHORD = NUMBER_OF_LINKS >= 2 ? (1 << 0) | (1 << (NUMBER_OF_LINKS - 1)) : 0;
 
 
 /* Components */
-Joystick joystick(A8, A9);
-
-Button button1(A3);
-Button button2(A2);
-Button button3(A1);
-Button button4(A0);
-
-Button *buttons[NUMBER_OF_LINKS] = {
-	&button1,
-	&button2,
-	&button3,
-	&button4
-};
-
-// 1. oben
-AccelStepper accelStepper1(AccelStepper::MotorInterfaceType::DRIVER, 28, 26);
-Stepper stepper1(accelStepper1);
-LimitBarrier limitBarrier1(21);
-
-// 1. rechts
-AccelStepper accelStepper2(AccelStepper::MotorInterfaceType::DRIVER, 45, 43);
-Stepper stepper2(accelStepper2);
-LimitBarrier limitBarrier2(20);
-
-// 1. unten
-AccelStepper accelStepper3(AccelStepper::MotorInterfaceType::DRIVER, 33, 31);
-Stepper stepper3(accelStepper3);
-LimitBarrier limitBarrier3(19);
-
-// 1. links
-AccelStepper accelStepper4(AccelStepper::MotorInterfaceType::DRIVER, 37, 35);
-Stepper stepper4(accelStepper4);
-LimitBarrier limitBarrier4(18);
-
-// 2. oben
-AccelStepper accelStepper5(AccelStepper::MotorInterfaceType::DRIVER, 41, 39);
-Stepper stepper5(accelStepper5);
-LimitBarrier limitBarrier5(17);
-
-// 2. rechts
-AccelStepper accelStepper6(AccelStepper::MotorInterfaceType::DRIVER, 32, 30);
-Stepper stepper6(accelStepper6);
-LimitBarrier limitBarrier6(0);
-
-// 2. unten
-AccelStepper accelStepper7(AccelStepper::MotorInterfaceType::DRIVER, 52, 50);
-Stepper stepper7(accelStepper7);
-LimitBarrier limitBarrier7(15);
-
-// 2. links
-AccelStepper accelStepper8(AccelStepper::MotorInterfaceType::DRIVER, 36, 34);
-Stepper stepper8(accelStepper8);
-LimitBarrier limitBarrier8(14);
-
-// 3. oben
-AccelStepper accelStepper9(AccelStepper::MotorInterfaceType::DRIVER, 25, 23);
-Stepper stepper9(accelStepper9);
-LimitBarrier limitBarrier9(1);
-
-// 3. rechts
-AccelStepper accelStepper10(AccelStepper::MotorInterfaceType::DRIVER, 44, 42);
-Stepper stepper10(accelStepper10);
-LimitBarrier limitBarrier10(16);
-
-// 3. unten
-AccelStepper accelStepper11(AccelStepper::MotorInterfaceType::DRIVER, 40, 38);
-Stepper stepper11(accelStepper11);
-LimitBarrier limitBarrier11(2);
-
-// 3. links
-AccelStepper accelStepper12(AccelStepper::MotorInterfaceType::DRIVER, 48, 46);
-Stepper stepper12(accelStepper12);
-LimitBarrier limitBarrier12(3);
-
-// 4. oben
-AccelStepper accelStepper13(AccelStepper::MotorInterfaceType::DRIVER, 49, 47);
-Stepper stepper13(accelStepper13);
-LimitBarrier limitBarrier13(4);
-
-// 4. rechts
-AccelStepper accelStepper14(AccelStepper::MotorInterfaceType::DRIVER, 53, 51);
-Stepper stepper14(accelStepper14);
-LimitBarrier limitBarrier14(5);
-
-// 4. unten
-AccelStepper accelStepper15(AccelStepper::MotorInterfaceType::DRIVER, 29, 27);
-Stepper stepper15(accelStepper15);
-LimitBarrier limitBarrier15(6);
-
-// 4. links
-AccelStepper accelStepper16(AccelStepper::MotorInterfaceType::DRIVER, 24, 22);
-Stepper stepper16(accelStepper16);
-LimitBarrier limitBarrier16(7);
-
-Stepper *steppers[NUMBER_OF_STEPPERS] = {
-	&stepper1,
-	&stepper2,
-	&stepper3,
-	&stepper4,
-	&stepper5,
-	&stepper6,
-	&stepper7,
-	&stepper8,
-	&stepper9,
-	&stepper10,
-	&stepper11,
-	&stepper12,
-	&stepper13,
-	&stepper14,
-	&stepper15,
-	&stepper16
-};
-
-
-Link link1(stepper1, stepper2, stepper3, stepper4, limitBarrier1, limitBarrier2, limitBarrier3, limitBarrier4);
-Link link2(stepper5, stepper6, stepper7, stepper8, limitBarrier5, limitBarrier6, limitBarrier7, limitBarrier8);
-Link link3(stepper9, stepper10, stepper11, stepper12, limitBarrier9, limitBarrier10, limitBarrier11, limitBarrier12);
-Link link4(stepper13, stepper14, stepper15, stepper16, limitBarrier13, limitBarrier14, limitBarrier15, limitBarrier16);
-
-Link *links[NUMBER_OF_LINKS] = {
-	&link1,
-	&link2,
-	&link3,
-	&link4,
-};
+Joystick joystick(JOYSTICK_X_PIN, JOYSTICK_Y_PIN);
 
+ButtonScanner buttonScanner;
+OutputCompareChannels outputCompareChannels;
+MotorTable motorTable;
+Link links[NUMBER_OF_LINKS];
+
+Trajectory trajectory(links);
+MovePlanner straightening(links);
+Homing homing(links);
+StackProbe stackProbe;
+Scheduler scheduler;
+ParameterTable parameterTable;
+LatencyMonitor latencyMonitor;
 
-/* Variables */
-boolean haveReachedBarriers = false; // Indicates whether the steppers have reached the barriers for the initialization
-boolean areCentered = false; // Indicates whether the steppers have reached the center for the initialization
-boolean isInitialized = false; // Indicates whether the initialization routine is finished
 
+/* Variables */
 uint8_t selectedLinkIndex = 0; // Indicates which link is currently selected
-uint8_t counter = 0;
+boolean isTelemetryEnabled = false; // Indicates whether the positions are sent periodically
+boolean isDriftCorrectionEnabled = false; // Indicates whether drifted positions are corrected at barrier edges
+HomingState reportedHomingStates[NUMBER_OF_LINKS]; // The homing states of the links that were sent last
+boolean isHomingReported = false; // Indicates whether the homing durations were sent
+char commandLine[COMMAND_LINE_LENGTH]; // The parameter command that is currently received
+uint8_t commandLineLength = 0; // The received characters of the parameter command
+boolean isReadingCommandLine = false; // Indicates whether a parameter command is currently received
+unsigned long straighteningStartTime = 0; // millis() when the straightening started
+unsigned long straighteningDuration = 0; // milliseconds until all links were straight
+boolean isStraighteningFinished = false; // Indicates whether a finished straightening has to be reported
 
 
 /* Method definitions */
-void initComponents();
-boolean haveReachedBarriersForInit();
-void setMovementsToBarrierForInit();
-boolean areCenteredForInit();
-void setMovementsToCenterForInit();
+void beginComponents();
+void addTasks();
 void getButtonState();
+void home();
+void readJoystick();
 void setMovements();
+void readSerialCommand();
+void processCommand(const char command);
+void processCommandLine();
+boolean parseLink(const char *argument, uint8_t &link);
+boolean parseValue(const char *argument, float &value);
+void printParameter(const uint8_t link, const uint8_t parameter);
+void applyParameters();
+void saveParameters();
+boolean isJoystickDeflected();
+void measureLatency();
+void printLatencyStatistics();
+void sendTelemetry();
+void sendHomingProgress();
+void startStraightening();
+void stopMovements();
+void sendStraighteningResult();
+void printTaskStatistics();
+void updateDriverPower();
+void monitorDrift();
+void printDriftStatistics();
 void update();
 
 
 /* Methods */
-void initComponents()
+void beginComponents()
+{
+	Timebase::begin();
+	motorTable.useOutputCompareChannels(outputCompareChannels);
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		if(!buttonScanner.assignButton(i, LINK_CONFIGS[i].buttonPin))
+		{
+			Serial.print(F("Button not on the common port: "));
+			Serial.println(i);
+		}
+
+		links[i].begin(LINK_CONFIGS[i], motorTable, i * STEPPERS_PER_LINK);
+
+		for(uint8_t j = 0; j < STEPPERS_PER_LINK; j++)
+		{
+			if(links[i].getTendonsOnSerialPins() & (1 << j))
+			{
+				Serial.print(F("Link "));
+				Serial.print(i);
+				Serial.print(F(" tendon "));
+				Serial.print(j);
+				Serial.println(F(": barrier on a serial pin, the link cannot be homed"));
+			}
+		}
+	}
+
+	parameterTable.begin();
+	applyParameters();
+}
+
+
+void addTasks()
 {
-	if(haveReachedBarriers == false)
+	// fast tasks first, the periodic tasks in the order of their priority
+	scheduler.addTask(update, 0);
+	scheduler.addTask(home, 0);
+	scheduler.addTask(monitorDrift, 0);
+	scheduler.addTask(applyParameters, 0);
+	scheduler.addTask(saveParameters, 0);
+	scheduler.addTask(setMovements, 0);
+	scheduler.addTask(measureLatency, 0);
+	scheduler.addTask(readJoystick, JOYSTICK_PERIOD);
+	scheduler.addTask(getButtonState, BUTTON_PERIOD);
+	scheduler.addTask(readSerialCommand, SERIAL_COMMAND_PERIOD);
+	scheduler.addTask(sendTelemetry, TELEMETRY_PERIOD);
+	scheduler.addTask(updateDriverPower, DRIVER_POWER_PERIOD);
+}
+
+
+void getButtonState()
+{
+	buttonScanner.scan();
+
+	const uint8_t pressedButtons = buttonScanner.takePressedButtons();
+
+	// the chord is complete when its last button is pressed while the others are held
+	if(pressedButtons & STRAIGHTEN_CHORD)
+	{
+		boolean isChordPressed = true;
+
+		for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+		{
+			if((STRAIGHTEN_CHORD & (1 << i)) && !buttonScanner.isButtonPressed(i))
+			{
+				isChordPressed = false;
+			}
+		}
+
+		if(isChordPressed)
+		{
+			startStraightening();
+			return;
+		}
+	}
+
+	// the lowest newly pressed button wins
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
 	{
-		if(haveReachedBarriersForInit())
+		if(pressedButtons & (1 << i))
 		{
-			haveReachedBarriers = true;
+			selectedLinkIndex = i;
+			return;
+		}
+	}
+}
+
+
+void home()
+{
+	homing.update();
+}
+
+
+void readJoystick()
+{
+	const boolean wasDeflected = isJoystickDeflected();
+	joystick.read();
+
+	if(!isJoystickDeflected())
+	{
+		latencyMonitor.abortMeasurement();
+		return;
+	}
+
+	// only a deflection out of the center starts a measurement, holding the joystick keeps the steppers running
+	if(!wasDeflected && links[selectedLinkIndex].isHomed() && !trajectory.isPlaying() && !straightening.isMoving())
+	{
+		unsigned long stepTimes[STEPPERS_PER_LINK];
+		links[selectedLinkIndex].getLastStepTimes(stepTimes);
+		latencyMonitor.startMeasurement(selectedLinkIndex, joystick.getSampleTime(), stepTimes);
+	}
+}
+
+
+boolean isJoystickDeflected()
+{
+	return joystick.getCurrentHorizontalDirection() != HorizontalDirection::HOR_NONE ||
+	       joystick.getCurrentVerticalDirection() != VerticalDirection::VERT_NONE;
+}
+
+
+// runs right after the step loop so that the step time is taken from the step that was just made
+void measureLatency()
+{
+	unsigned long stepTime = 0;
+
+	if(latencyMonitor.isMeasuring() &&
+	   links[latencyMonitor.getLink()].hasSteppedSince(latencyMonitor.getStepTimes(), stepTime))
+	{
+		latencyMonitor.finishMeasurement(stepTime);
+	}
+}
+
+
+void setMovements()
+{
+	if(straightening.isMoving())
+	{
+		straightening.update();
+
+		if(!straightening.isMoving())
+		{
+			straighteningDuration = millis() - straighteningStartTime;
+			isStraighteningFinished = true;
+		}
+
+		return;
+	}
+
+	if(trajectory.isPlaying())
+	{
+		trajectory.update();
+		return;
+	}
+
+	// every link can be controlled as soon as it is homed
+	if(!links[selectedLinkIndex].isHomed())
+	{
+		return;
+	}
+
+	links[selectedLinkIndex].setHorizontalDirectionMovement(joystick.getCurrentHorizontalDirection());
+	links[selectedLinkIndex].setVerticalDirectionMovement(joystick.getCurrentVerticalDirection());
+}
+
+
+void readSerialCommand()
+{
+	while(Serial.available() > 0)
+	{
+		const char character = Serial.read();
+
+		if(!isReadingCommandLine)
+		{
+			if(character == '$')
+			{
+				isReadingCommandLine = true;
+				commandLineLength = 0;
+			}
+			else
+			{
+				processCommand(character);
+			}
+		}
+		else if(character == '\n' || character == '\r')
+		{
+			commandLine[commandLineLength] = '\0';
+			isReadingCommandLine = false;
+			processCommandLine();
+		}
+		else if(commandLineLength < COMMAND_LINE_LENGTH - 1)
+		{
+			commandLine[commandLineLength] = character;
+			commandLineLength++;
+		}
+	}
+}
+
+
+void processCommand(const char command)
+{
+	if(command == 'r')
+	{
+		// the positions of a link that is not homed yet mean nothing after the next homing
+		if(!homing.isFinished())
+		{
+			Serial.println(F("Homing not finished"));
+		}
+		else if(trajectory.recordKeyframe())
+		{
+			Serial.print(F("Keyframe recorded: "));
+			Serial.println(trajectory.getNumberOfKeyframes());
 		}
 		else
 		{
-			setMovementsToBarrierForInit();
+			Serial.println(F("Keyframe not recorded"));
 		}
 	}
-	else if(areCentered == false)
+	else if(command == 'p')
 	{
-		if(areCenteredForInit())
+		if(!homing.isFinished())
+		{
+			Serial.println(F("Homing not finished"));
+		}
+		else if(straightening.isMoving())
+		{
+			Serial.println(F("Straightening running"));
+		}
+		else if(trajectory.startPlayback())
 		{
-			areCentered = true;
+			Serial.println(F("Playback started"));
 		}
 		else
 		{
-			setMovementsToCenterForInit();
+			Serial.println(F("No keyframes recorded"));
 		}
 	}
+	else if(command == 's')
+	{
+		stopMovements();
+		Serial.println(F("Playback stopped"));
+	}
+	else if(command == 'g')
+	{
+		startStraightening();
+	}
+	else if(command == 'c')
+	{
+		trajectory.clear();
+		Serial.println(F("Keyframes cleared"));
+	}
+	else if(command == 'm')
+	{
+		Serial.print(F("Static RAM: "));
+		Serial.print(stackProbe.getStaticRamBytes());
+		Serial.print(F(" bytes, unused stack: "));
+		Serial.print(stackProbe.getUnusedStackBytes());
+		Serial.println(F(" bytes"));
+	}
+	else if(command == 'a')
+	{
+		homing.abort();
+		stopMovements();
+	}
+	else if(command == 'h')
+	{
+		stopMovements();
+		homing.start(false);
+		isHomingReported = false;
+	}
+	else if(command == 'b')
+	{
+		// the measured slack is printed with the drift statistics
+		stopMovements();
+		homing.start(true);
+		isHomingReported = false;
+	}
+	else if(command == 'd')
+	{
+		printDriftStatistics();
+	}
+	else if(command == 'z')
+	{
+		isDriftCorrectionEnabled = !isDriftCorrectionEnabled;
+
+		for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+		{
+			links[i].setDriftCorrection(isDriftCorrectionEnabled);
+		}
+
+		Serial.print(F("Drift correction: "));
+		Serial.println(isDriftCorrectionEnabled);
+	}
+	else if(command == 't')
+	{
+		isTelemetryEnabled = !isTelemetryEnabled;
+	}
+	else if(command == 'o')
+	{
+		printTaskStatistics();
+	}
+	else if(command == 'l')
+	{
+		printLatencyStatistics();
+	}
 	else
 	{
-		isInitialized = true;
+		// ignore unknown commands and line endings
 	}
 }
 
 
-boolean haveReachedBarriersForInit()
+// $ lists all parameters, $get <name> [link], $set <name> <value> [link], $save, $load, $defaults
+void processCommandLine()
 {
+	const char *command = strtok(commandLine, " ");
+
+	if(command == nullptr)
+	{
+		for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+		{
+			for(uint8_t j = 0; j < ParameterTable::NUMBER_OF_PARAMETERS; j++)
+			{
+				printParameter(i, j);
+			}
+		}
+
+		return;
+	}
+
+	if(strcmp_P(command, PSTR("save")) == 0)
+	{
+		// saveParameters() writes the bytes and reports the end
+		parameterTable.save();
+		return;
+	}
+
+	if(strcmp_P(command, PSTR("load")) == 0)
+	{
+		if(parameterTable.isSaving())
+		{
+			Serial.println(F("Parameters are being saved"));
+			return;
+		}
+
+		Serial.println(parameterTable.load() ? F("Parameters loaded") : F("No valid parameters stored"));
+		return;
+	}
+
+	if(strcmp_P(command, PSTR("defaults")) == 0)
+	{
+		parameterTable.restoreDefaults();
+		Serial.println(F("Default parameters restored"));
+		return;
+	}
+
+	const boolean isSetCommand = strcmp_P(command, PSTR("set")) == 0;
+
+	if(!isSetCommand && strcmp_P(command, PSTR("get")) != 0)
+	{
+		Serial.println(F("Unknown parameter command"));
+		return;
+	}
+
+	const char *name = strtok(nullptr, " ");
+	const uint8_t parameter = name != nullptr ? parameterTable.findParameter(name) : ParameterTable::NUMBER_OF_PARAMETERS;
+
+	if(parameter >= ParameterTable::NUMBER_OF_PARAMETERS)
+	{
+		Serial.println(F("Unknown parameter"));
+		return;
+	}
+
+	const char *valueArgument = isSetCommand ? strtok(nullptr, " ") : nullptr;
+	uint8_t link = ParameterTable::ALL_LINKS;
+
+	if(!parseLink(strtok(nullptr, " "), link))
+	{
+		Serial.print(F("Invalid link, 0 to "));
+		Serial.println(NUMBER_OF_LINKS - 1);
+		return;
+	}
+
+	float value = 0;
+
+	if(isSetCommand && (!parseValue(valueArgument, value) || !parameterTable.setValue(link, parameter, value)))
+	{
+		Serial.print(F("Invalid parameter value, range "));
+		Serial.print(parameterTable.getMinValue(parameter));
+		Serial.print(F(" to "));
+		Serial.print(parameterTable.getMaxValue(parameter));
+		Serial.println(F(" and slow <= fast <= maxspeed"));
+		return;
+	}
+
 	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
 	{
-		if(links[i]->haveReachedLimitBarriersForInit() == false)
+		if(link == ParameterTable::ALL_LINKS || link == i)
 		{
-			return false;
+			printParameter(i, parameter);
 		}
 	}
+}
+
+
+// no argument selects all links, anything but the number of a link is rejected
+boolean parseLink(const char *argument, uint8_t &link)
+{
+	if(argument == nullptr)
+	{
+		link = ParameterTable::ALL_LINKS;
+		return true;
+	}
 
+	char *end = nullptr;
+	const long number = strtol(argument, &end, 10);
+
+	if(end == argument || *end != '\0' || number < 0 || number >= NUMBER_OF_LINKS)
+	{
+		return false;
+	}
+
+	link = number;
 	return true;
 }
 
 
-void setMovementsToBarrierForInit()
+// the whole argument has to be a number, atof() would read "abc" as 0, which is a valid jerk
+boolean parseValue(const char *argument, float &value)
+{
+	if(argument == nullptr)
+	{
+		return false;
+	}
+
+	char *end = nullptr;
+	value = strtod(argument, &end);
+	return end != argument && *end == '\0';
+}
+
+
+void printParameter(const uint8_t link, const uint8_t parameter)
 {
+	Serial.print(F("Link "));
+	Serial.print(link);
+	Serial.print(' ');
+	Serial.print(reinterpret_cast<const __FlashStringHelper *>(parameterTable.getName(parameter)));
+	Serial.print(F(" = "));
+	Serial.println(parameterTable.getValue(link, parameter));
+}
+
+
+// the links take over changed parameters between two control cycles, never in the middle of one
+void applyParameters()
+{
+	if(!parameterTable.hasPendingChanges())
+	{
+		return;
+	}
+
 	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
 	{
-		links[i]->setMovementsToLimitBarrierForInit();
+		links[i].setParameters(parameterTable.getLinkParameters(i));
+	}
+
+	parameterTable.clearPendingChanges();
+}
+
+
+// one byte per pass, the EEPROM takes 3.3 ms for every byte that changed
+void saveParameters()
+{
+	if(parameterTable.isSaving() && !parameterTable.continueSave())
+	{
+		Serial.println(F("Parameters saved"));
+	}
+}
+
+
+void sendTelemetry()
+{
+	sendHomingProgress();
+	sendStraighteningResult();
+
+	if(!isTelemetryEnabled)
+	{
+		return;
+	}
+
+	long positions[STEPPERS_PER_LINK];
+	links[selectedLinkIndex].getStepperPositions(positions);
+
+	Serial.print(F("T "));
+	Serial.print(selectedLinkIndex);
+
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		Serial.print(' ');
+		Serial.print(positions[i]);
 	}
+
+	Serial.println();
 }
 
 
-boolean areCenteredForInit()
+void sendHomingProgress()
 {
 	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
 	{
-		if(links[i]->isCenteredForInit() == false)
+		const HomingState state = links[i].getHomingState();
+
+		if(state == reportedHomingStates[i])
 		{
-			return false;
+			continue;
+		}
+
+		reportedHomingStates[i] = state;
+		Serial.print(F("Link "));
+		Serial.print(i);
+		Serial.print(F(" homing state: "));
+		Serial.println(static_cast<uint8_t>(state));
+
+		if(state == HomingState::HOMING_FAILED)
+		{
+			Serial.print(F("Link "));
+			Serial.print(i);
+			Serial.println(F(" homing failed, a barrier is on a serial pin"));
 		}
 	}
 
-	return true;
+	if(isHomingReported || !homing.isFinished())
+	{
+		return;
+	}
+
+	isHomingReported = true;
+	Serial.print(F("Homing finished, first link usable after "));
+	Serial.print(homing.getFirstLinkDuration());
+	Serial.print(F(" ms, all links after "));
+	Serial.print(homing.getDuration());
+	Serial.println(F(" ms"));
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		for(uint8_t j = 0; j < STEPPERS_PER_LINK; j++)
+		{
+			if(links[i].getFailedSlackMeasurements() & (1 << j))
+			{
+				Serial.print(F("Link "));
+				Serial.print(i);
+				Serial.print(F(" tendon "));
+				Serial.print(j);
+				Serial.println(F(": barrier did not release, slack not measured"));
+			}
+		}
+	}
 }
 
 
-void setMovementsToCenterForInit()
+/**
+ * \brief Moves all links to the center at the max speed of every link. The tendon pairs of a link move in
+ *        opposite directions and all tendons arrive at the same time, so no tendon runs slack or pulls against
+ *        its partner.
+ */
+void startStraightening()
 {
-	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	if(!homing.isFinished())
 	{
-		links[i]->setMovementsToCenterForInit();
+		Serial.println(F("Homing not finished"));
+		return;
 	}
+
+	const long positions[NUMBER_OF_STEPPERS] = {};
+
+	trajectory.stopPlayback();
+	straightening.start(positions, 0);
+	straighteningStartTime = millis();
+	isStraighteningFinished = false;
+
+	Serial.print(F("Straightening, planned "));
+	Serial.print(straightening.getPlannedDuration());
+	Serial.println(F(" ms"));
 }
 
-void getButtonState()
+
+void stopMovements()
+{
+	trajectory.stopPlayback();
+	straightening.stop();
+}
+
+
+void sendStraighteningResult()
+{
+	if(!isStraighteningFinished)
+	{
+		return;
+	}
+
+	isStraighteningFinished = false;
+	Serial.print(F("Straightening finished after "));
+	Serial.print(straighteningDuration);
+	Serial.println(F(" ms"));
+}
+
+
+void printTaskStatistics()
 {
-	for(int i = NUMBER_OF_LINKS - 1; i >= 0; i--)
+	for(uint8_t i = 0; i < scheduler.getNumberOfTasks(); i++)
 	{
-		if(buttons[i]->isButtonPressed())
+		Serial.print(F("Task "));
+		Serial.print(i);
+		Serial.print(F(": period "));
+		Serial.print(scheduler.getPeriod(i));
+		Serial.print(F(" us, overruns "));
+		Serial.print(scheduler.getOverruns(i));
+		Serial.print(F(", max lateness "));
+		Serial.print(scheduler.getMaxLateness(i));
+		Serial.println(F(" us"));
+	}
+
+	scheduler.resetStatistics();
+}
+
+
+void printLatencyStatistics()
+{
+	for(uint8_t i = 0; i < LatencyMonitor::NUMBER_OF_BUCKETS; i++)
+	{
+		Serial.print(F("L "));
+
+		if(i < LatencyMonitor::NUMBER_OF_BUCKETS - 1)
 		{
-			selectedLinkIndex = i;
+			Serial.print('<');
+			Serial.print(latencyMonitor.getBucketLimit(i));
 		}
+		else
+		{
+			Serial.print(F(">="));
+			Serial.print(latencyMonitor.getBucketLimit(i - 1));
+		}
+
+		Serial.print(F(" us: "));
+		Serial.println(latencyMonitor.getBucketCount(i));
 	}
+
+	Serial.print(F("Latency: measurements "));
+	Serial.print(latencyMonitor.getNumberOfMeasurements());
+	Serial.print(F(", aborts "));
+	Serial.print(latencyMonitor.getNumberOfAborts());
+	Serial.print(F(", mean "));
+	Serial.print(latencyMonitor.getMeanLatency());
+	Serial.print(F(" us, max "));
+	Serial.print(latencyMonitor.getMaxLatency());
+	Serial.println(F(" us"));
+
+	latencyMonitor.reset();
 }
 
 
-void setMovements()
+void updateDriverPower()
 {
-	getButtonState();
-	joystick.read();
+	const unsigned long now = millis();
 
-	links[selectedLinkIndex]->setHorizontalDirectionMovement(joystick.getCurrentHorizontalDirection());
-	links[selectedLinkIndex]->setVerticalDirectionMovement(joystick.getCurrentVerticalDirection());
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		links[i].updateDriverPower(now);
+	}
 }
 
 
-void update()
+void monitorDrift()
 {
 	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
 	{
-		links[i]->update();
+		links[i].monitorDrift();
 	}
 }
 
 
-void setup()
+void printDriftStatistics()
 {
-	Serial.begin(9600);
-
-	while(!isInitialized)
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
 	{
-		initComponents();
-		update();
+		for(uint8_t j = 0; j < STEPPERS_PER_LINK; j++)
+		{
+			const DriftMonitor &driftMonitor = links[i].getDriftMonitor(j);
+
+			Serial.print(F("Link "));
+			Serial.print(i);
+			Serial.print(F(" tendon "));
+			Serial.print(j);
+			Serial.print(F(": edges "));
+			Serial.print(driftMonitor.getNumberOfEdges());
+			Serial.print(F(", last error "));
+			Serial.print(driftMonitor.getLastError());
+			Serial.print(F(", max error "));
+			Serial.print(driftMonitor.getMaxAbsoluteError());
+			Serial.print(F(", error sum "));
+			Serial.print(driftMonitor.getErrorSum());
+			Serial.print(F(", missing edges "));
+			Serial.print(driftMonitor.getNumberOfMissingEdges());
+			Serial.print(F(", corrections "));
+			Serial.print(driftMonitor.getNumberOfCorrections());
+			Serial.print(F(", backlash "));
+			Serial.println(links[i].getBacklash(j));
+		}
 	}
 }
 
 
+void update()
+{
+	motorTable.run();
+}
+
+
+void setup()
+{
+	stackProbe.paint();
+	Serial.begin(115200);
+	beginComponents();
+	addTasks();
+	homing.start(false);
+}
+
+
 void loop()
 {
-	setMovements();
-	update();
+	scheduler.run(micros());
 }
@@ -0,0 +1,177 @@
+#include "Arduino.h"
+#include "Homing.h"
+
+
+/**
+ * \brief Assigns the links that are homed.
+ * \param links	The links of the endoscope.
+ */
+Homing::Homing(Link *links) : _links(links)
+{}
+
+
+/**
+ * \brief Starts the homing of all links. The links are unusable until they are homed again.
+ * \param isMeasuringSlack	true = the links measure the slack of their tendons, which takes a little longer
+ */
+void Homing::start(const boolean isMeasuringSlack)
+{
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		_links[i].resetHoming();
+	}
+
+	_isRunning = true;
+	_isMeasuringSlack = isMeasuringSlack;
+	_startTime = millis();
+	_duration = 0;
+	_firstLinkDuration = 0;
+}
+
+
+/**
+ * \brief Starts the next links and sets their homing movements. Has to be called as often as possible while
+ *        the homing runs.
+ */
+void Homing::update()
+{
+	if(!_isRunning)
+	{
+		return;
+	}
+
+	uint8_t numberOfHomingLinks = getNumberOfHomingLinks();
+	uint8_t nextLink = getNextLinkToHome();
+
+	while(numberOfHomingLinks < MAX_SIMULTANEOUSLY_HOMING_LINKS && nextLink != NO_LINK)
+	{
+		_links[nextLink].startHoming(_isMeasuringSlack);
+		numberOfHomingLinks++;
+		nextLink = getNextLinkToHome();
+	}
+
+	boolean areAllDone = true;
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		_links[i].updateHoming();
+
+		if(_links[i].isHomed())
+		{
+			if(_firstLinkDuration == 0)
+			{
+				_firstLinkDuration = millis() - _startTime;
+			}
+		}
+		else if(_links[i].getHomingState() != HomingState::HOMING_FAILED)
+		{
+			areAllDone = false;
+		}
+	}
+
+	// a failed link ends the homing as well, but the homing does not count as finished
+	if(areAllDone)
+	{
+		_isRunning = false;
+		_duration = millis() - _startTime;
+	}
+}
+
+
+/**
+ * \brief Stops the homing. Links that are already homed stay usable, the others until the homing is started
+ *        again.
+ */
+void Homing::abort()
+{
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		_links[i].abortHoming();
+	}
+
+	_isRunning = false;
+}
+
+
+boolean Homing::isRunning() const
+{
+	return _isRunning;
+}
+
+
+/**
+ * \brief Indicates whether all links are homed.
+ * \return true = finished
+ */
+boolean Homing::isFinished() const
+{
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		if(!_links[i].isHomed())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/**
+ * \brief The time until all links were homed.
+ * \return The duration in milliseconds, 0 while the homing is not finished.
+ */
+unsigned long Homing::getDuration() const
+{
+	return _duration;
+}
+
+
+/**
+ * \brief The time until the first link was homed and could be controlled.
+ * \return The duration in milliseconds, 0 while no link is homed.
+ */
+unsigned long Homing::getFirstLinkDuration() const
+{
+	return _firstLinkDuration;
+}
+
+
+uint8_t Homing::getNumberOfHomingLinks() const
+{
+	uint8_t numberOfHomingLinks = 0;
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		const HomingState state = _links[i].getHomingState();
+
+		if(state == HomingState::HOMING_TO_BARRIERS || state == HomingState::HOMING_TO_CENTER ||
+		   state == HomingState::HOMING_MEASURING_SLACK)
+		{
+			numberOfHomingLinks++;
+		}
+	}
+
+	return numberOfHomingLinks;
+}
+
+
+uint8_t Homing::getNextLinkToHome() const
+{
+	uint8_t nextLink = NO_LINK;
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		if(_links[i].getHomingState() != HomingState::HOMING_IDLE)
+		{
+			continue;
+		}
+
+		if(nextLink == NO_LINK || _links[i].getHomingRank() < _links[nextLink].getHomingRank())
+		{
+			nextLink = i;
+		}
+	}
+
+	return nextLink;
+}
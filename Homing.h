@@ -0,0 +1,50 @@
+#ifndef HOMING_H
+#define HOMING_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "HomingState.h"
+#include "Link.h"
+
+
+
+/**
+ * Homes the links without blocking. Every link has its own homing state and becomes usable as soon as it is
+ * centered. The links are started in the order of their homing rank, and at most
+ * MAX_SIMULTANEOUSLY_HOMING_LINKS of them move at the same time to limit the peak motor current.
+ */
+class Homing
+{
+public:
+	/* Constructors */
+	Homing(Link *links);
+
+	/* Methods */
+	void start(const boolean isMeasuringSlack);
+	void update();
+	void abort();
+	boolean isRunning() const;
+	boolean isFinished() const;
+	unsigned long getDuration() const;
+	unsigned long getFirstLinkDuration() const;
+
+private:
+	/* Constants */
+	static const uint8_t NO_LINK = 0xFF;
+
+	/* Variables */
+	boolean _isRunning = false;
+	boolean _isMeasuringSlack = false; // the links measure the slack of their tendons at the barriers
+	unsigned long _startTime = 0; // millis() when the homing started
+	unsigned long _duration = 0; // milliseconds until all links were homed
+	unsigned long _firstLinkDuration = 0; // milliseconds until the first link was usable
+
+	/* Components */
+	Link *_links;
+
+	/* Methods */
+	uint8_t getNumberOfHomingLinks() const;
+	uint8_t getNextLinkToHome() const;
+};
+
+#endif // HOMING_H
@@ -0,0 +1,17 @@
+#ifndef HOMING_STATE_H
+#define HOMING_STATE_H
+
+
+
+enum class HomingState
+{
+	HOMING_IDLE = 0,
+	HOMING_TO_BARRIERS = 1,
+	HOMING_TO_CENTER = 2,
+	HOMING_FINISHED = 3,
+	HOMING_ABORTED = 4,
+	HOMING_MEASURING_SLACK = 5,
+	HOMING_FAILED = 6 // a barrier of the link cannot be read, the link stays unusable
+};
+
+#endif // HOMING_STATE_H
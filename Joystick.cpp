@@ -22,6 +22,7 @@ Joystick::Joystick(const int xPin, const int yPin)
  */
 void Joystick::read()
 {
+	_sampleTime = Timebase::getTicks();
 	const uint16_t xValue = analogRead(_xPin);
 	const uint16_t yValue = analogRead(_yPin);
 	
@@ -50,6 +51,16 @@ VerticalDirection Joystick::getCurrentVerticalDirection() const
 }
 
 
+/**
+ * \brief The time the last sample was taken, the first conversion starts right after it.
+ * \return The Timebase ticks of the last read.
+ */
+unsigned long Joystick::getSampleTime() const
+{
+	return _sampleTime;
+}
+
+
 /**
  * \brief Converts the read analog value into a horizontal direction value.
  * \param horValue		The analog value that should be converted.
@@ -4,6 +4,7 @@
 #include "Arduino.h"
 #include "HorizontalDirection.h"
 #include "VerticalDirection.h"
+#include "Timebase.h"
 
 
 
@@ -17,6 +18,7 @@ public:
 	void read();
 	HorizontalDirection getCurrentHorizontalDirection() const;
 	VerticalDirection getCurrentVerticalDirection() const;
+	unsigned long getSampleTime() const;
 
 private:
 	/* Constants */
@@ -27,6 +29,7 @@ private:
 	/* Variables */
 	int _xPin; // analog pin for the horizontal value
 	int _yPin; // analog pin for the vertical value
+	unsigned long _sampleTime = 0; // Timebase ticks when the last sample was started
 	HorizontalDirection horDir = HorizontalDirection::HOR_NONE;
 	VerticalDirection vertDir = VerticalDirection::VERT_NONE;
 
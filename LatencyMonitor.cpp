@@ -0,0 +1,149 @@
+#include "Arduino.h"
+#include "LatencyMonitor.h"
+
+
+/**
+ * \brief Starts to wait for the first step after a joystick sample.
+ * \param link			The index of the link that is moved.
+ * \param sampleTime	The Timebase ticks when the joystick was sampled.
+ * \param stepTimes		The last step times of the link, the first one that changes ends the measurement.
+ */
+void LatencyMonitor::startMeasurement(const uint8_t link, const unsigned long sampleTime,
+                                      const unsigned long stepTimes[])
+{
+	_link = link;
+	_sampleTime = sampleTime;
+
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		_stepTimes[i] = stepTimes[i];
+	}
+
+	_isMeasuring = true;
+}
+
+
+/**
+ * \brief Adds the latency up to the first step to the histogram.
+ * \param stepTime	The Timebase ticks of the first step.
+ */
+void LatencyMonitor::finishMeasurement(const unsigned long stepTime)
+{
+	const unsigned long latency = (stepTime - _sampleTime) / Timebase::TICKS_PER_MICROSECOND;
+	uint8_t bucket = 0;
+
+	while(bucket < NUMBER_OF_BUCKETS - 1 && latency >= getBucketLimit(bucket))
+	{
+		bucket++;
+	}
+
+	_bucketCounts[bucket]++;
+	_numberOfMeasurements++;
+	_maxLatency = max(_maxLatency, latency);
+	_latencySum += latency;
+	_isMeasuring = false;
+}
+
+
+/**
+ * \brief Stops waiting without a step, e.g. because the joystick was released or the tendon is blocked.
+ */
+void LatencyMonitor::abortMeasurement()
+{
+	if(_isMeasuring)
+	{
+		_numberOfAborts++;
+		_isMeasuring = false;
+	}
+}
+
+
+boolean LatencyMonitor::isMeasuring() const
+{
+	return _isMeasuring;
+}
+
+
+uint8_t LatencyMonitor::getLink() const
+{
+	return _link;
+}
+
+
+unsigned long LatencyMonitor::getSampleTime() const
+{
+	return _sampleTime;
+}
+
+
+const unsigned long *LatencyMonitor::getStepTimes() const
+{
+	return _stepTimes;
+}
+
+
+/**
+ * \brief Clears the histogram. A running measurement continues.
+ */
+void LatencyMonitor::reset()
+{
+	for(uint8_t i = 0; i < NUMBER_OF_BUCKETS; i++)
+	{
+		_bucketCounts[i] = 0;
+	}
+
+	_numberOfMeasurements = 0;
+	_numberOfAborts = 0;
+	_maxLatency = 0;
+	_latencySum = 0;
+}
+
+
+uint16_t LatencyMonitor::getBucketCount(const uint8_t bucket) const
+{
+	return _bucketCounts[bucket];
+}
+
+
+/**
+ * \brief The exclusive upper limit of a bucket.
+ * \param bucket	The index of the bucket.
+ * \return The limit in microseconds.
+ */
+unsigned long LatencyMonitor::getBucketLimit(const uint8_t bucket) const
+{
+	return 1UL << (bucket + FIRST_BUCKET_SHIFT);
+}
+
+
+uint16_t LatencyMonitor::getNumberOfMeasurements() const
+{
+	return _numberOfMeasurements;
+}
+
+
+uint16_t LatencyMonitor::getNumberOfAborts() const
+{
+	return _numberOfAborts;
+}
+
+
+unsigned long LatencyMonitor::getMaxLatency() const
+{
+	return _maxLatency;
+}
+
+
+/**
+ * \brief The mean of all measured latencies.
+ * \return The mean in microseconds, 0 without measurements.
+ */
+unsigned long LatencyMonitor::getMeanLatency() const
+{
+	if(_numberOfMeasurements == 0)
+	{
+		return 0;
+	}
+
+	return _latencySum / _numberOfMeasurements;
+}
@@ -0,0 +1,51 @@
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "Timebase.h"
+
+
+
+/**
+ * Measures the time from the joystick sample that starts a movement to the first step pulse it causes and collects
+ * the latencies in a histogram. The upper limit of bucket i is 2^(i + FIRST_BUCKET_SHIFT) microseconds, the last
+ * bucket is open ended.
+ */
+class LatencyMonitor
+{
+public:
+	/* Constants */
+	static const uint8_t NUMBER_OF_BUCKETS = 12;
+	static const uint8_t FIRST_BUCKET_SHIFT = 7; // the first bucket ends at 128 microseconds
+
+	/* Methods */
+	void startMeasurement(const uint8_t link, const unsigned long sampleTime, const unsigned long stepTimes[]);
+	void finishMeasurement(const unsigned long stepTime);
+	void abortMeasurement();
+	boolean isMeasuring() const;
+	uint8_t getLink() const;
+	unsigned long getSampleTime() const;
+	const unsigned long *getStepTimes() const;
+	void reset();
+	uint16_t getBucketCount(const uint8_t bucket) const;
+	unsigned long getBucketLimit(const uint8_t bucket) const;
+	uint16_t getNumberOfMeasurements() const;
+	uint16_t getNumberOfAborts() const;
+	unsigned long getMaxLatency() const;
+	unsigned long getMeanLatency() const;
+
+private:
+	/* Variables */
+	boolean _isMeasuring = false;
+	uint8_t _link = 0; // index of the link the measured movement belongs to
+	unsigned long _sampleTime = 0; // Timebase ticks of the joystick sample
+	unsigned long _stepTimes[STEPPERS_PER_LINK]; // last step times of the link at the sample
+	uint16_t _bucketCounts[NUMBER_OF_BUCKETS];
+	uint16_t _numberOfMeasurements = 0;
+	uint16_t _numberOfAborts = 0; // movements that were released before a step happened
+	unsigned long _maxLatency = 0; // microseconds
+	unsigned long _latencySum = 0; // microseconds
+};
+
+#endif // LATENCY_MONITOR_H
@@ -3,13 +3,20 @@
 
 
 /**
- * \brief Assigns the pin and sets it to input mode.
+ * \brief Sets the pin to input mode and resolves its port so that reading it costs a single register access. A pin
+ *        of Serial is left to the UART, the barrier is never reached then.
  * \param pin	The digital pin value on the arduino.
  */
-LimitBarrier::LimitBarrier(const uint8_t pin)
+void LimitBarrier::begin(const uint8_t pin)
 {
-	_pin = pin;
-	pinMode(_pin, INPUT);
+	if(pin == SERIAL_RX_PIN || pin == SERIAL_TX_PIN)
+	{
+		return;
+	}
+
+	pinMode(pin, INPUT);
+	_inputRegister = portInputRegister(digitalPinToPort(pin));
+	_bitMask = digitalPinToBitMask(pin);
 }
 
 
@@ -19,10 +26,23 @@ LimitBarrier::LimitBarrier(const uint8_t pin)
  */
 boolean LimitBarrier::hasReachedBarrier() const
 {
-	if(digitalRead(this->_pin) == HIGH)
+	if(_inputRegister == nullptr || (*_inputRegister & _bitMask))
 	{
 		return false;
 	}
 
 	return true;
 }
+
+
+/**
+ * \brief Indicates whether the limit barrier was reached since the last call.
+ * \return true = the barrier switched from free to reached
+ */
+boolean LimitBarrier::hasNewlyReachedBarrier()
+{
+	const boolean isReached = hasReachedBarrier();
+	const boolean isNewlyReached = isReached && !_wasReached;
+	_wasReached = isReached;
+	return isNewlyReached;
+}
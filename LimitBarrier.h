@@ -2,21 +2,23 @@
 #define LIMIT_BARRIER_H
 
 #include "Arduino.h"
+#include "Configuration.h"
 
 
 
 class LimitBarrier
 {
 public:
-	/* Constructors */
-	LimitBarrier(const uint8_t pin);
-
 	/* Methods */
+	void begin(const uint8_t pin);
 	boolean hasReachedBarrier() const;
+	boolean hasNewlyReachedBarrier();
 
 private:
 	/* Variables */
-	uint8_t _pin; // Represents the assigned pin on the arduino.
+	volatile uint8_t *_inputRegister = nullptr; // Input register of the port the assigned pin belongs to, nullptr = no pin.
+	uint8_t _bitMask = 0; // Bit of the assigned pin within the port.
+	boolean _wasReached = false; // state of the last edge check
 };
 
 #endif // LIMIT_BARRIER_H
@@ -2,16 +2,185 @@
 #include "Link.h"
 
 
-Link::Link(Stepper &stepperUp, Stepper &stepperRight, Stepper &stepperDown, Stepper &stepperLeft,
-           LimitBarrier &limitBarrierUp, LimitBarrier &limitBarrierRight, LimitBarrier &limitBarrierDown,
-           LimitBarrier &limitBarrierLeft)
-	: _stepperUp(stepperUp), _stepperRight(stepperRight), _stepperDown(stepperDown), _stepperLeft(stepperLeft),
-	  _limitBarrierUp(limitBarrierUp), _limitBarrierRight(limitBarrierRight), _limitBarrierDown(limitBarrierDown),
-	  _limitBarrierLeft(limitBarrierLeft)
-{}
+void Link::begin(const LinkConfig &config, MotorTable &motorTable, const uint8_t firstMotor)
+{
+	_stepperUp.begin(motorTable, firstMotor, config.up, _rampTable);
+	_stepperRight.begin(motorTable, firstMotor + 1, config.right, _rampTable);
+	_stepperDown.begin(motorTable, firstMotor + 2, config.down, _rampTable);
+	_stepperLeft.begin(motorTable, firstMotor + 3, config.left, _rampTable);
+	_limitBarrierUp.begin(config.up.barrierPin);
+	_limitBarrierRight.begin(config.right.barrierPin);
+	_limitBarrierDown.begin(config.down.barrierPin);
+	_limitBarrierLeft.begin(config.left.barrierPin);
+	_tendonsOnSerialPins = 0;
+
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		const TendonConfig &tendon = i == 0 ? config.up : i == 1 ? config.right : i == 2 ? config.down : config.left;
+
+		if(tendon.barrierPin == SERIAL_RX_PIN || tendon.barrierPin == SERIAL_TX_PIN)
+		{
+			_tendonsOnSerialPins |= 1 << i;
+		}
+	}
+
+	_homingRank = config.homingRank;
+	_idleTimeout = config.idleTimeout;
+	_holdTolerance = config.holdTolerance;
+	_driverEnable.begin(config.enablePin);
+	setParameters(DEFAULT_MOTION_PARAMETERS);
+}
+
+
+/**
+ * \brief Replaces the motion parameters. Has to be called between two control cycles so that all movements of a
+ *        cycle use the same parameters.
+ * \param parameters	The new parameters of this link.
+ */
+void Link::setParameters(const MotionParameters &parameters)
+{
+	_parameters = parameters;
+	_negMaxPosition = -static_cast<float>(_parameters.maxPosition) / _parameters.posNegSpeedFactor;
+	_speedProfile.build(_parameters, _negMaxPosition);
+	_rampTable.build(_parameters);
+
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		getStepper(i).setTakeUpInterval(_speedProfile.getTakeUpInterval());
+	}
+}
+
+
+void Link::resetHoming()
+{
+	_homingState = HomingState::HOMING_IDLE;
+}
+
+
+/**
+ * \brief Starts the homing of this link. A link with a barrier on a serial pin fails at once, the barrier would
+ *        read the serial traffic.
+ * \param isMeasuringSlack	true = measure the slack of the tendons at the barriers before the link is centered
+ */
+void Link::startHoming(const boolean isMeasuringSlack)
+{
+	if(_tendonsOnSerialPins != 0)
+	{
+		_homingState = HomingState::HOMING_FAILED;
+		return;
+	}
+
+	_isMeasuringSlack = isMeasuringSlack;
+	_homingState = HomingState::HOMING_TO_BARRIERS;
+}
+
+
+void Link::updateHoming()
+{
+	if(_homingState == HomingState::HOMING_TO_BARRIERS)
+	{
+		if(haveReachedLimitBarriersForInit() && _isMeasuringSlack)
+		{
+			startSlackMeasurement();
+		}
+		else if(haveReachedLimitBarriersForInit())
+		{
+			// the centering counts the steps from -1 so that pos_neg_factor has no influence
+			setStepperPositionsForInit(-1);
+
+			for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+			{
+				_barrierPositions[i] = 0;
+			}
+
+			_homingState = HomingState::HOMING_TO_CENTER;
+		}
+		else
+		{
+			setMovementsToLimitBarrierForInit();
+		}
+	}
+	else if(_homingState == HomingState::HOMING_TO_CENTER)
+	{
+		if(isCenteredForInit())
+		{
+			_homingState = HomingState::HOMING_FINISHED;
+		}
+		else
+		{
+			setMovementsToCenterForInit();
+		}
+	}
+	else if(_homingState == HomingState::HOMING_MEASURING_SLACK)
+	{
+		if(isSlackMeasured())
+		{
+			// tighten the tendons at the barriers again before the link is centered
+			_isMeasuringSlack = false;
+			_homingState = HomingState::HOMING_TO_BARRIERS;
+		}
+		else
+		{
+			setMovementsToReleaseBarriers();
+		}
+	}
+	else
+	{
+		// nothing to do while idle, finished or aborted
+	}
+}
 
 
-boolean Link::haveReachedLimitBarriersForInit() const
+void Link::abortHoming()
+{
+	if(_homingState == HomingState::HOMING_TO_BARRIERS || _homingState == HomingState::HOMING_TO_CENTER ||
+	   _homingState == HomingState::HOMING_MEASURING_SLACK)
+	{
+		_homingState = HomingState::HOMING_ABORTED;
+	}
+}
+
+
+HomingState Link::getHomingState() const
+{
+	return _homingState;
+}
+
+
+boolean Link::isHomed() const
+{
+	return _homingState == HomingState::HOMING_FINISHED;
+}
+
+
+uint8_t Link::getHomingRank() const
+{
+	return _homingRank;
+}
+
+
+/**
+ * \brief The slack that is taken up after a reversal of a tendon.
+ * \param tendon	0 = up, 1 = right, 2 = down, 3 = left
+ * \return The slack in full steps.
+ */
+uint8_t Link::getBacklash(const uint8_t tendon)
+{
+	return getStepper(tendon).getBacklash();
+}
+
+
+/**
+ * \brief The tendons whose slack could not be measured at the last homing because their barrier never released.
+ * \return One bit per tendon, bit 0 = up.
+ */
+uint8_t Link::getFailedSlackMeasurements() const
+{
+	return _failedSlackMeasurements;
+}
+
+
+boolean Link::haveReachedLimitBarriersForInit()
 {
 	if(_limitBarrierUp.hasReachedBarrier() && _limitBarrierRight.hasReachedBarrier() &&
 		_limitBarrierDown.hasReachedBarrier() && _limitBarrierLeft.hasReachedBarrier())
@@ -23,7 +192,7 @@ boolean Link::haveReachedLimitBarriersForInit() const
 }
 
 
-void Link::setMovementsToLimitBarrierForInit() const
+void Link::setMovementsToLimitBarrierForInit()
 {
 	// reset that max position will not be reached accidentally
 	// -1 so that pos_neg_factor has no influence
@@ -36,9 +205,27 @@ void Link::setMovementsToLimitBarrierForInit() const
 }
 
 
-boolean Link::isCenteredForInit() const
+boolean Link::isCenteredForInit()
 {
-	if(limitToCenterCounter >= POS_MAX_POSITION)
+	if(isMoving())
+	{
+		return false;
+	}
+
+	// only steps that changed the positions count, a take-up leaves them where they were. The tendon that moved
+	// least decides
+	long centeringSteps = 0;
+
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		_barrierPositions[i] += max(-1 - getStepper(i).getCurrentPosition(), 0L);
+		centeringSteps = i == 0 ? _barrierPositions[i] : min(centeringSteps, _barrierPositions[i]);
+	}
+
+	setStepperPositionsForInit(-1);
+
+	// the steps back from the barriers become the barrier positions, the drift is checked against them
+	if(centeringSteps >= _parameters.maxPosition)
 	{
 		setStepperPositionsForInit(0);
 		return true;
@@ -55,17 +242,198 @@ void Link::setMovementsToCenterForInit()
 		return;
 	}
 
-	// set position the way that pos_neg_factor has no influence
-	setStepperPositionsForInit(-1);
 	prepareForFastBackwardMovement(_stepperUp);
 	prepareForFastBackwardMovement(_stepperRight);
 	prepareForFastBackwardMovement(_stepperDown);
 	prepareForFastBackwardMovement(_stepperLeft);
-	limitToCenterCounter++;
 }
 
 
-void Link::setHorizontalDirectionMovement(const HorizontalDirection horizontalDirection) const
+/**
+ * \brief Starts to measure the slack of the tendons. All tendons are tight at their barriers; a tendon that turns
+ *        back first has to take up its slack before the barrier releases.
+ */
+void Link::startSlackMeasurement()
+{
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		// the slack is counted in plain steps, a take-up would hide it
+		getStepper(i).setBacklash(0);
+		_slackSteps[i] = 0;
+	}
+
+	_failedSlackMeasurements = 0;
+
+	_homingState = HomingState::HOMING_MEASURING_SLACK;
+}
+
+
+/**
+ * \brief Takes over the measured slack once all barriers are released. The step that releases a barrier is not
+ *        slack, the remainder includes the hysteresis of the barrier. A barrier that did not release within the
+ *        counter failed, its tendon keeps a backlash of 0.
+ * \return true = slack of all tendons measured
+ */
+boolean Link::isSlackMeasured()
+{
+	if(isMoving() || !isBarrierReleased(_limitBarrierUp, 0) || !isBarrierReleased(_limitBarrierRight, 1) ||
+	   !isBarrierReleased(_limitBarrierDown, 2) || !isBarrierReleased(_limitBarrierLeft, 3))
+	{
+		return false;
+	}
+
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		if(_slackSteps[i] == UINT8_MAX)
+		{
+			_failedSlackMeasurements |= 1 << i;
+			getStepper(i).setBacklash(0);
+		}
+		else
+		{
+			getStepper(i).setBacklash(_slackSteps[i] > 0 ? _slackSteps[i] - 1 : 0);
+		}
+	}
+
+	return true;
+}
+
+
+void Link::setMovementsToReleaseBarriers()
+{
+	if(isMoving())
+	{
+		return;
+	}
+
+	// -1 so that the end positions do not stop the measurement
+	setStepperPositionsForInit(-1);
+	releaseBarrier(_stepperUp, _limitBarrierUp, 0);
+	releaseBarrier(_stepperRight, _limitBarrierRight, 1);
+	releaseBarrier(_stepperDown, _limitBarrierDown, 2);
+	releaseBarrier(_stepperLeft, _limitBarrierLeft, 3);
+}
+
+
+void Link::releaseBarrier(Stepper &stepper, LimitBarrier &limitBarrier, const uint8_t tendon)
+{
+	if(isBarrierReleased(limitBarrier, tendon))
+	{
+		return;
+	}
+
+	if(prepareForBackwardMovement(stepper))
+	{
+		_slackSteps[tendon]++;
+	}
+}
+
+
+/**
+ * \brief Disables the drivers after the idle timeout. Drivers of a bent link stay enabled, otherwise the
+ *        tension of its tendons would collapse.
+ * \param now	The current time in milliseconds.
+ */
+void Link::updateDriverPower(const unsigned long now)
+{
+	if(_hasMoved || isMoving())
+	{
+		_hasMoved = false;
+		_lastMovementTime = now;
+		return;
+	}
+
+	if(_idleTimeout == 0 || !_driverEnable.isEnabled())
+	{
+		return;
+	}
+
+	if(now - _lastMovementTime < _idleTimeout || isHoldingTension())
+	{
+		return;
+	}
+
+	_driverEnable.disable();
+}
+
+
+boolean Link::areDriversEnabled() const
+{
+	return _driverEnable.isEnabled();
+}
+
+
+/**
+ * \brief Compares the limit barrier edges with the counted positions. The barriers switch at the positive end
+ *        position, any other position at the edge means that steps were lost. Has to be called as often as
+ *        possible so that the edge is seen at the step that caused it.
+ */
+void Link::monitorDrift()
+{
+	checkDrift(_stepperUp, _limitBarrierUp, _driftMonitorUp, 0);
+	checkDrift(_stepperRight, _limitBarrierRight, _driftMonitorRight, 1);
+	checkDrift(_stepperDown, _limitBarrierDown, _driftMonitorDown, 2);
+	checkDrift(_stepperLeft, _limitBarrierLeft, _driftMonitorLeft, 3);
+}
+
+
+/**
+ * \brief Selects whether a drifted position is set back to the barrier position at the next barrier edge.
+ * \param isEnabled	true = correct the position
+ */
+void Link::setDriftCorrection(const boolean isEnabled)
+{
+	_isDriftCorrectionEnabled = isEnabled;
+}
+
+
+/**
+ * \brief The drift statistics of a tendon.
+ * \param tendon	0 = up, 1 = right, 2 = down, 3 = left
+ * \return The drift monitor of the tendon.
+ */
+const DriftMonitor &Link::getDriftMonitor(const uint8_t tendon) const
+{
+	if(tendon == 0)
+	{
+		return _driftMonitorUp;
+	}
+
+	if(tendon == 1)
+	{
+		return _driftMonitorRight;
+	}
+
+	if(tendon == 2)
+	{
+		return _driftMonitorDown;
+	}
+
+	return _driftMonitorLeft;
+}
+
+
+/**
+ * \brief The tendons whose barriers share a pin with Serial. These barriers are not read, the serial traffic would
+ *        look like barrier edges; the link fails its homing and its drift is not checked.
+ * \return One bit per tendon, bit 0 = up.
+ */
+uint8_t Link::getTendonsOnSerialPins() const
+{
+	return _tendonsOnSerialPins;
+}
+
+
+void Link::resetDriftMonitors()
+{
+	_driftMonitorUp.reset();
+	_driftMonitorRight.reset();
+	_driftMonitorDown.reset();
+	_driftMonitorLeft.reset();
+}
+
+
+void Link::setHorizontalDirectionMovement(const HorizontalDirection horizontalDirection)
 {
 	if(horizontalDirection == HorizontalDirection::HOR_RIGHT_FAST)
 	{
@@ -94,7 +462,7 @@ void Link::setHorizontalDirectionMovement(const HorizontalDirection horizontalDi
 }
 
 
-void Link::setVerticalDirectionMovement(const VerticalDirection verticalDirection) const
+void Link::setVerticalDirectionMovement(const VerticalDirection verticalDirection)
 {
 	if(verticalDirection == VerticalDirection::VERT_UP_FAST)
 	{
@@ -123,7 +491,7 @@ void Link::setVerticalDirectionMovement(const VerticalDirection verticalDirectio
 }
 
 
-boolean Link::isMoving() const
+boolean Link::isMoving()
 {
 	if(_stepperUp.isRunning() || _stepperRight.isRunning() || _stepperDown.isRunning() || _stepperLeft.isRunning())
 	{
@@ -134,16 +502,174 @@ boolean Link::isMoving() const
 }
 
 
-void Link::update() const
+void Link::getStepperPositions(long positions[])
+{
+	positions[0] = _stepperUp.getCurrentPosition();
+	positions[1] = _stepperRight.getCurrentPosition();
+	positions[2] = _stepperDown.getCurrentPosition();
+	positions[3] = _stepperLeft.getCurrentPosition();
+}
+
+
+void Link::getLastStepTimes(unsigned long stepTimes[])
+{
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		stepTimes[i] = getStepper(i).getLastStepTime();
+	}
+}
+
+
+/**
+ * \brief Checks whether a stepper of this link stepped since its step times were taken. The times are compared
+ *        for a change only, so a step that lies any time back cannot pass for a new one.
+ * \param stepTimes	The step times from getLastStepTimes().
+ * \param stepTime	Receives the Timebase ticks of the new step.
+ * \return true = a stepper stepped since then
+ */
+boolean Link::hasSteppedSince(const unsigned long stepTimes[], unsigned long &stepTime)
+{
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		const unsigned long lastStepTime = getStepper(i).getLastStepTime();
+
+		if(lastStepTime != stepTimes[i])
+		{
+			stepTime = lastStepTime;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/**
+ * \brief The shortest time in which every tendon can reach its position. A tendon accelerates along the ramp of
+ *        the link, moves at constant speed and brakes along the same ramp; a short move only accelerates and
+ *        brakes. The jerk phases of an S-curve ramp are neglected.
+ * \param positions	The target positions of the tendons in steps.
+ * \param speedLimit	Steps per second no tendon exceeds, 0 = the max speed of the link.
+ * \return The duration in seconds of the tendon that needs longest.
+ */
+float Link::getMinMoveDuration(const long positions[], const float speedLimit)
+{
+	long currentPositions[STEPPERS_PER_LINK];
+	getStepperPositions(currentPositions);
+
+	const float speed = getMoveSpeed(speedLimit);
+	const float acceleration = _parameters.acceleration;
+	float duration = 0;
+
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		const float distance = abs(positions[i] - currentPositions[i]);
+
+		if(distance >= speed * speed / acceleration)
+		{
+			// ramp up and down take v / a each and cover v^2 / (2a) each, the rest is cruised at the speed
+			duration = max(duration, distance / speed + speed / acceleration);
+		}
+		else
+		{
+			// triangular, half of the distance each way
+			duration = max(duration, 2 * sqrt(distance / acceleration));
+		}
+	}
+
+	return duration;
+}
+
+
+/**
+ * \brief Computes the intervals that let every tendon arrive after the same duration. A tendon that ramps up to
+ *        the speed v, cruises and brakes needs d / v + v / a, so the speed of a tendon is the smaller root
+ *        v = a / 2 (T - sqrt(T^2 - 4d / a)). Tendons with a shorter distance therefore cruise slower; all of them
+ *        brake along the ramp in front of their positions.
+ * \param positions	The target positions of the tendons in steps.
+ * \param duration		The duration in seconds, at least the one of getMinMoveDuration().
+ * \param speedLimit	Steps per second no tendon exceeds, 0 = the max speed of the link.
+ * \param intervals	Receives the Timebase ticks between two steps of every tendon.
+ */
+void Link::planMovementsToPositions(const long positions[], const float duration, const float speedLimit,
+                                    uint16_t intervals[])
 {
-	_stepperUp.step();
-	_stepperRight.step();
-	_stepperDown.step();
-	_stepperLeft.step();
+	long currentPositions[STEPPERS_PER_LINK];
+	getStepperPositions(currentPositions);
+
+	const float maxSpeed = getMoveSpeed(speedLimit);
+	const float acceleration = _parameters.acceleration;
+
+	for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+	{
+		const float distance = abs(positions[i] - currentPositions[i]);
+		const float radicand = duration * duration - 4 * distance / acceleration;
+
+		// the cruise speed v solves duration = distance / v + v / a. A negative radicand is a rounding error of the
+		// tendon that defines the duration
+		float speed = acceleration / 2 * (duration - sqrt(max(radicand, 0)));
+		speed = constrain(speed, MIN_MOVE_SPEED, maxSpeed);
+		intervals[i] = Timebase::TICKS_PER_SECOND / speed;
+	}
 }
 
 
-void Link::setStepperPositionsForInit(const long position) const
+boolean Link::setMovementsToPositions(const long positions[], const uint16_t intervals[])
+{
+	// evaluate every stepper so that all of them keep moving
+	const boolean hasReachedUp = prepareForMovementToPosition(_stepperUp, _limitBarrierUp, positions[0],
+	                                                          intervals[0]);
+	const boolean hasReachedRight = prepareForMovementToPosition(_stepperRight, _limitBarrierRight, positions[1],
+	                                                             intervals[1]);
+	const boolean hasReachedDown = prepareForMovementToPosition(_stepperDown, _limitBarrierDown, positions[2],
+	                                                            intervals[2]);
+	const boolean hasReachedLeft = prepareForMovementToPosition(_stepperLeft, _limitBarrierLeft, positions[3],
+	                                                            intervals[3]);
+
+	return hasReachedUp && hasReachedRight && hasReachedDown && hasReachedLeft;
+}
+
+
+boolean Link::isBarrierReleased(LimitBarrier &limitBarrier, const uint8_t tendon)
+{
+	// the slack does not fit into the counter if the barrier never releases, the measurement gives up on it
+	return !limitBarrier.hasReachedBarrier() || _slackSteps[tendon] == UINT8_MAX;
+}
+
+
+Stepper &Link::getStepper(const uint8_t tendon)
+{
+	if(tendon == 0)
+	{
+		return _stepperUp;
+	}
+
+	if(tendon == 1)
+	{
+		return _stepperRight;
+	}
+
+	if(tendon == 2)
+	{
+		return _stepperDown;
+	}
+
+	return _stepperLeft;
+}
+
+
+float Link::getMoveSpeed(const float speedLimit) const
+{
+	if(speedLimit <= 0 || speedLimit > _parameters.maxSpeed)
+	{
+		return _parameters.maxSpeed;
+	}
+
+	return max(speedLimit, MIN_MOVE_SPEED);
+}
+
+
+void Link::setStepperPositionsForInit(const long position)
 {
 	_stepperUp.setCurrentPosition(position);
 	_stepperRight.setCurrentPosition(position);
@@ -152,20 +678,68 @@ void Link::setStepperPositionsForInit(const long position) const
 }
 
 
-boolean Link::hasReachedPositiveEndPosition(Stepper &stepper) const
+void Link::enableDrivers()
+{
+	_hasMoved = true;
+	_driverEnable.enable();
+}
+
+
+boolean Link::isHoldingTension()
 {
-	if(stepper.getCurrentPosition() >= POS_MAX_POSITION)
+	return abs(_stepperUp.getCurrentPosition()) > _holdTolerance ||
+	       abs(_stepperRight.getCurrentPosition()) > _holdTolerance ||
+	       abs(_stepperDown.getCurrentPosition()) > _holdTolerance ||
+	       abs(_stepperLeft.getCurrentPosition()) > _holdTolerance;
+}
+
+
+void Link::checkDrift(Stepper &stepper, LimitBarrier &limitBarrier, DriftMonitor &driftMonitor,
+                      const uint8_t tendon)
+{
+	// the edge state is tracked during the homing as well, otherwise its last edge would be evaluated later
+	const boolean isNewlyReached = limitBarrier.hasNewlyReachedBarrier();
+	const uint8_t tendonBit = 1 << tendon;
+
+	if(!isHomed() || (_tendonsOnSerialPins & tendonBit))
 	{
-		return true;
+		return;
 	}
 
-	return false;
+	// the barrier position is the one found by the homing, a changed max position does not move it
+	const long position = stepper.getCurrentPosition();
+	const long barrierPosition = _barrierPositions[tendon];
+
+	if(isNewlyReached)
+	{
+		const long error = position - barrierPosition;
+		driftMonitor.addEdge(error);
+
+		if(_isDriftCorrectionEnabled && abs(error) > DRIFT_TOLERANCE)
+		{
+			stepper.setCurrentPosition(barrierPosition);
+			driftMonitor.addCorrection();
+		}
+	}
+
+	if(position < barrierPosition || stepper.isRunning() || limitBarrier.hasReachedBarrier())
+	{
+		_tendonsAtEndWithoutBarrier &= ~tendonBit;
+		return;
+	}
+
+	// the tendon stands at its barrier position but the barrier is still free
+	if((_tendonsAtEndWithoutBarrier & tendonBit) == 0)
+	{
+		_tendonsAtEndWithoutBarrier |= tendonBit;
+		driftMonitor.addMissingEdge();
+	}
 }
 
 
-boolean Link::hasReachedNegativeEndPosition(Stepper &stepper) const
+boolean Link::hasReachedPositiveEndPosition(Stepper &stepper)
 {
-	if(stepper.getCurrentPosition() <= NEG_MAX_POSITION)
+	if(stepper.getCurrentPosition() >= _parameters.maxPosition)
 	{
 		return true;
 	}
@@ -174,9 +748,9 @@ boolean Link::hasReachedNegativeEndPosition(Stepper &stepper) const
 }
 
 
-boolean Link::isInPositivePosition(Stepper &stepper) const
+boolean Link::hasReachedNegativeEndPosition(Stepper &stepper)
 {
-	if(stepper.getCurrentPosition() >= 0)
+	if(stepper.getCurrentPosition() <= _negMaxPosition)
 	{
 		return true;
 	}
@@ -185,65 +759,90 @@ boolean Link::isInPositivePosition(Stepper &stepper) const
 }
 
 
-boolean Link::prepareForFastForwardMovement(Stepper &stepper, LimitBarrier &limitBarrier) const
+boolean Link::prepareForFastForwardMovement(Stepper &stepper, LimitBarrier &limitBarrier)
 {
 	if(hasReachedPositiveEndPosition(stepper) || limitBarrier.hasReachedBarrier())
 	{
 		return false;
 	}
 
-	if(isInPositivePosition(stepper))
-	{
-		return stepper.setForwardMovement(SPEED_FAST * POS_NEG_SPEED_FACTOR);
-	}
-
-	return stepper.setForwardMovement(SPEED_FAST);
+	enableDrivers();
+	return stepper.moveForward(_speedProfile.getInterval(stepper.getCurrentPosition(), SpeedProfile::FORWARD_FAST));
 }
 
 
-boolean Link::prepareForForwardMovement(Stepper &stepper, LimitBarrier &limitBarrier) const
+boolean Link::prepareForForwardMovement(Stepper &stepper, LimitBarrier &limitBarrier)
 {
 	if(hasReachedPositiveEndPosition(stepper) || limitBarrier.hasReachedBarrier())
 	{
 		return false;
 	}
 
-	if(isInPositivePosition(stepper))
-	{
-		return stepper.setForwardMovement(SPEED_SLOW * POS_NEG_SPEED_FACTOR);
-	}
-
-	return stepper.setForwardMovement(SPEED_SLOW);
+	enableDrivers();
+	return stepper.moveForward(_speedProfile.getInterval(stepper.getCurrentPosition(), SpeedProfile::FORWARD_SLOW));
 }
 
 
-boolean Link::prepareForFastBackwardMovement(Stepper &stepper) const
+boolean Link::prepareForFastBackwardMovement(Stepper &stepper)
 {
 	if(hasReachedNegativeEndPosition(stepper))
 	{
 		return false;
 	}
 
-	if(isInPositivePosition(stepper))
+	enableDrivers();
+	return stepper.moveBackward(_speedProfile.getInterval(stepper.getCurrentPosition(), SpeedProfile::BACKWARD_FAST));
+}
+
+
+boolean Link::prepareForBackwardMovement(Stepper &stepper)
+{
+	if(hasReachedNegativeEndPosition(stepper))
 	{
-		return stepper.setBackwardMovement(SPEED_FAST * POS_NEG_SPEED_FACTOR);
+		return false;
 	}
 
-	return stepper.setBackwardMovement(SPEED_FAST);
+	enableDrivers();
+	return stepper.moveBackward(_speedProfile.getInterval(stepper.getCurrentPosition(), SpeedProfile::BACKWARD_SLOW));
 }
 
 
-boolean Link::prepareForBackwardMovement(Stepper &stepper) const
+boolean Link::prepareForMovementToPosition(Stepper &stepper, LimitBarrier &limitBarrier, const long position,
+                                           const uint16_t interval)
 {
-	if(hasReachedNegativeEndPosition(stepper))
+	const long currentPosition = stepper.getCurrentPosition();
+	const boolean isForward = currentPosition < position;
+
+	// the tendon brakes along the ramp, read backwards from the target, and along the envelope in front of the
+	// end position it heads to. The envelope includes the max speed
+	const uint16_t remainingSteps = min(abs(position - currentPosition), 0xFFFFL);
+	const uint16_t limitedInterval = max(max(interval, _rampTable.getInterval(remainingSteps)),
+	                                     _speedProfile.getEnvelopeInterval(currentPosition, isForward));
+
+	if(isForward)
 	{
+		// a blocked stepper counts as arrived, otherwise the playback would wait forever
+		if(hasReachedPositiveEndPosition(stepper) || limitBarrier.hasReachedBarrier())
+		{
+			return true;
+		}
+
+		enableDrivers();
+		stepper.moveForward(limitedInterval);
 		return false;
 	}
 
-	if(isInPositivePosition(stepper))
+	if(currentPosition > position)
 	{
-		return stepper.setBackwardMovement(SPEED_SLOW * POS_NEG_SPEED_FACTOR);
+		if(hasReachedNegativeEndPosition(stepper))
+		{
+			return true;
+		}
+
+		enableDrivers();
+		stepper.moveBackward(limitedInterval);
+		return false;
 	}
 
-	return stepper.setBackwardMovement(SPEED_SLOW);
+	return true;
 }
@@ -2,64 +2,119 @@
 #define LINK_H
 
 #include "Arduino.h"
+#include "Configuration.h"
+#include "MotionParameters.h"
+#include "SpeedProfile.h"
+#include "Timebase.h"
+#include "RampTable.h"
+#include "HomingState.h"
 #include "HorizontalDirection.h"
 #include "VerticalDirection.h"
+#include "MotorTable.h"
 #include "Stepper.h"
 #include "LimitBarrier.h"
+#include "DriverEnable.h"
+#include "DriftMonitor.h"
 
 
 
 class Link
 {
 public:
-	/* Constructors */
-	Link(Stepper &stepperUp, Stepper &stepperRight, Stepper &stepperDown, Stepper &stepperLeft,
-	     LimitBarrier &limitBarrierUp, LimitBarrier &limitBarrierRight, LimitBarrier &limitBarrierDown,
-	     LimitBarrier &limitBarrierLeft);
-
-
 	/* Methods */
-	boolean haveReachedLimitBarriersForInit() const;
-	void setMovementsToLimitBarrierForInit() const;
-	boolean isCenteredForInit() const;
-	void setMovementsToCenterForInit();
-	void setHorizontalDirectionMovement(const HorizontalDirection horizontalDirection) const;
-	void setVerticalDirectionMovement(const VerticalDirection verticalDirection) const;
-	boolean isMoving() const;
-	void update() const;
+	void begin(const LinkConfig &config, MotorTable &motorTable, const uint8_t firstMotor);
+	void setParameters(const MotionParameters &parameters);
+	void resetHoming();
+	void startHoming(const boolean isMeasuringSlack);
+	void updateHoming();
+	void abortHoming();
+	HomingState getHomingState() const;
+	uint8_t getBacklash(const uint8_t tendon);
+	uint8_t getFailedSlackMeasurements() const;
+	boolean isHomed() const;
+	uint8_t getHomingRank() const;
+	void updateDriverPower(const unsigned long now);
+	boolean areDriversEnabled() const;
+	void monitorDrift();
+	void setDriftCorrection(const boolean isEnabled);
+	const DriftMonitor &getDriftMonitor(const uint8_t tendon) const;
+	uint8_t getTendonsOnSerialPins() const;
+	void resetDriftMonitors();
+	void setHorizontalDirectionMovement(const HorizontalDirection horizontalDirection);
+	void setVerticalDirectionMovement(const VerticalDirection verticalDirection);
+	boolean isMoving();
+	void getStepperPositions(long positions[]);
+	void getLastStepTimes(unsigned long stepTimes[]);
+	boolean hasSteppedSince(const unsigned long stepTimes[], unsigned long &stepTime);
+	float getMinMoveDuration(const long positions[], const float speedLimit);
+	void planMovementsToPositions(const long positions[], const float duration, const float speedLimit,
+	                              uint16_t intervals[]);
+	boolean setMovementsToPositions(const long positions[], const uint16_t intervals[]);
 
 private:
 	/* Constants */
-	const float SPEED_SLOW = 250;
-	const float SPEED_FAST = 500;
-	const float POS_NEG_SPEED_FACTOR = 1.25;
-
-	const long POS_MAX_POSITION = 1600;
-	const long NEG_MAX_POSITION = -static_cast<float>(POS_MAX_POSITION) / POS_NEG_SPEED_FACTOR;
+	const long DRIFT_TOLERANCE = 2; // steps a barrier edge may differ before the position is corrected
+	const float MIN_MOVE_SPEED = 31; // steps per second, slower intervals do not fit into 16 bit
 
 
 	/* Variables */
-	long limitToCenterCounter = 0;
+	MotionParameters _parameters = DEFAULT_MOTION_PARAMETERS;
+	long _negMaxPosition = 0; // negative end position in steps, derived from the parameters
+	SpeedProfile _speedProfile;
+	RampTable _rampTable;
+	long _barrierPositions[STEPPERS_PER_LINK]; // steps each tendon moved back from its barrier at the homing
+	HomingState _homingState = HomingState::HOMING_IDLE;
+	uint8_t _homingRank = 0;
+	uint16_t _idleTimeout = 0;
+	uint16_t _holdTolerance = 0;
+	boolean _hasMoved = false; // Indicates whether a movement was commanded since the last power update
+	unsigned long _lastMovementTime = 0; // millis() of the last power update that saw a movement
+	boolean _isDriftCorrectionEnabled = false;
+	uint8_t _tendonsAtEndWithoutBarrier = 0; // one bit per tendon, the missing edge was recorded already
+	uint8_t _tendonsOnSerialPins = 0; // one bit per tendon, its barrier shares a pin with Serial
+	boolean _isMeasuringSlack = false; // the slack is measured once the barriers are reached
+	uint8_t _slackSteps[STEPPERS_PER_LINK]; // steps backward until the barrier of a tendon was released
+	uint8_t _failedSlackMeasurements = 0; // one bit per tendon, its barrier did not release
 
 	/* Components */
-	Stepper &_stepperUp;
-	Stepper &_stepperRight;
-	Stepper &_stepperDown;
-	Stepper &_stepperLeft;
-	LimitBarrier &_limitBarrierUp;
-	LimitBarrier &_limitBarrierRight;
-	LimitBarrier &_limitBarrierDown;
-	LimitBarrier &_limitBarrierLeft;
+	Stepper _stepperUp;
+	Stepper _stepperRight;
+	Stepper _stepperDown;
+	Stepper _stepperLeft;
+	LimitBarrier _limitBarrierUp;
+	LimitBarrier _limitBarrierRight;
+	LimitBarrier _limitBarrierDown;
+	LimitBarrier _limitBarrierLeft;
+	DriverEnable _driverEnable;
+	DriftMonitor _driftMonitorUp;
+	DriftMonitor _driftMonitorRight;
+	DriftMonitor _driftMonitorDown;
+	DriftMonitor _driftMonitorLeft;
 
 	/* Methods */
-	void setStepperPositionsForInit(const long position) const;
-	boolean hasReachedPositiveEndPosition(Stepper &stepper) const;
-	boolean hasReachedNegativeEndPosition(Stepper &stepper) const;
-	boolean isInPositivePosition(Stepper &stepper) const;
-	boolean prepareForFastForwardMovement(Stepper &stepper, LimitBarrier &limitBarrier) const;
-	boolean prepareForForwardMovement(Stepper &stepper, LimitBarrier &limitBarrier) const;
-	boolean prepareForFastBackwardMovement(Stepper &stepper) const;
-	boolean prepareForBackwardMovement(Stepper &stepper) const;
+	boolean haveReachedLimitBarriersForInit();
+	void setMovementsToLimitBarrierForInit();
+	boolean isCenteredForInit();
+	void setMovementsToCenterForInit();
+	void startSlackMeasurement();
+	boolean isSlackMeasured();
+	void setMovementsToReleaseBarriers();
+	void releaseBarrier(Stepper &stepper, LimitBarrier &limitBarrier, const uint8_t tendon);
+	boolean isBarrierReleased(LimitBarrier &limitBarrier, const uint8_t tendon);
+	Stepper &getStepper(const uint8_t tendon);
+	void setStepperPositionsForInit(const long position);
+	float getMoveSpeed(const float speedLimit) const;
+	void enableDrivers();
+	boolean isHoldingTension();
+	void checkDrift(Stepper &stepper, LimitBarrier &limitBarrier, DriftMonitor &driftMonitor, const uint8_t tendon);
+	boolean hasReachedPositiveEndPosition(Stepper &stepper);
+	boolean hasReachedNegativeEndPosition(Stepper &stepper);
+	boolean prepareForFastForwardMovement(Stepper &stepper, LimitBarrier &limitBarrier);
+	boolean prepareForForwardMovement(Stepper &stepper, LimitBarrier &limitBarrier);
+	boolean prepareForFastBackwardMovement(Stepper &stepper);
+	boolean prepareForBackwardMovement(Stepper &stepper);
+	boolean prepareForMovementToPosition(Stepper &stepper, LimitBarrier &limitBarrier, const long position,
+	                                     const uint16_t interval);
 };
 
 #endif
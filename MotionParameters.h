@@ -0,0 +1,21 @@
+#ifndef MOTION_PARAMETERS_H
+#define MOTION_PARAMETERS_H
+
+#include "Arduino.h"
+
+
+
+struct MotionParameters
+{
+	float speedSlow; // steps per second
+	float speedFast; // steps per second
+	float posNegSpeedFactor; // speed factor in the positive range, the negative range is shorter by this factor
+	long maxPosition; // positive end position in steps
+	float maxSpeed; // steps per second that no stepper exceeds
+	float deceleration; // steps per second squared the tendons brake with in front of the end positions
+	float acceleration; // steps per second squared the tendons start with
+	float jerk; // steps per second cubed, 0 = trapezoidal ramp, otherwise the acceleration changes smoothly
+	float takeUpSpeed; // steps per second the slack of a tendon is taken up with after a reversal
+};
+
+#endif // MOTION_PARAMETERS_H
@@ -0,0 +1,293 @@
+#include "Arduino.h"
+#include "MotorTable.h"
+
+
+/**
+ * \brief Lets the motors that are begun afterwards use the hardware channels if their step pin allows it.
+ * \param outputCompareChannels	The channels that generate hardware timed pulses.
+ */
+void MotorTable::useOutputCompareChannels(OutputCompareChannels &outputCompareChannels)
+{
+	_outputCompareChannels = &outputCompareChannels;
+}
+
+
+/**
+ * \brief Assigns the pins of a motor and sets them to output mode. The motor starts at position 0.
+ * \param motor			The index of the motor.
+ * \param stepPin		The digital pin that receives the step pulses.
+ * \param directionPin	The digital pin that selects the direction.
+ */
+void MotorTable::begin(const uint8_t motor, const uint8_t stepPin, const uint8_t directionPin)
+{
+	pinMode(stepPin, OUTPUT);
+	pinMode(directionPin, OUTPUT);
+
+	_stepPortIndices[motor] = findStepPort(portOutputRegister(digitalPinToPort(stepPin)));
+	_stepBitMasks[motor] = digitalPinToBitMask(stepPin);
+	_directionRegisters[motor] = portOutputRegister(digitalPinToPort(directionPin));
+	_directionBitMasks[motor] = digitalPinToBitMask(directionPin);
+
+	*_directionRegisters[motor] &= ~_directionBitMasks[motor];
+	_directions[motor / 8] &= ~(1 << (motor % 8));
+	_scheduledStepTimes[motor] = 0;
+	_lastStepTimes[motor] = 0;
+	_intervals[motor] = 0;
+	_hardwareChannels[motor] = OutputCompareChannels::NO_CHANNEL;
+	_positions[motor] = 0;
+	_targetPositions[motor] = 0;
+
+	if(_outputCompareChannels != nullptr)
+	{
+		_hardwareChannels[motor] = _outputCompareChannels->allocate(stepPin);
+	}
+}
+
+
+/**
+ * \brief Steps every motor whose interval has elapsed and that has not reached its target yet. The step pins of
+ *        all due motors go high together at the end of a run and low together at the start of the next one, so
+ *        the pulse lasts one loop without waiting for it. Has to be called as often as possible.
+ */
+void MotorTable::run()
+{
+	setStepPins(false);
+
+	const unsigned long now = Timebase::getTicks();
+	uint8_t steppingMotors[NUMBER_OF_STEPPERS];
+	uint8_t numberOfSteppingMotors = 0;
+
+	for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+	{
+		if(_positions[i] == _targetPositions[i])
+		{
+			continue;
+		}
+
+		const unsigned long elapsed = now - _scheduledStepTimes[i];
+
+		if(elapsed < _intervals[i])
+		{
+			continue;
+		}
+
+		// the direction pins are written here, before any step pin rises
+		prepareStep(i);
+		_raisedStepMasks[_stepPortIndices[i]] |= _stepBitMasks[i];
+		steppingMotors[numberOfSteppingMotors] = i;
+		numberOfSteppingMotors++;
+
+		// advancing by the interval keeps the rate exact at short intervals, after a pause the motor starts from now
+		if(elapsed < 2UL * _intervals[i])
+		{
+			_scheduledStepTimes[i] += _intervals[i];
+		}
+		else
+		{
+			_scheduledStepTimes[i] = now;
+		}
+	}
+
+	if(numberOfSteppingMotors == 0)
+	{
+		return;
+	}
+
+	// the step time is the edge itself, not the time the step was due
+	const unsigned long edgeTime = Timebase::getTicks();
+	setStepPins(true);
+
+	for(uint8_t i = 0; i < numberOfSteppingMotors; i++)
+	{
+		_lastStepTimes[steppingMotors[i]] = edgeTime;
+	}
+}
+
+
+/**
+ * \brief Moves the target of a motor relative to its current target, so the next steps can be queued while the
+ *        motor still runs.
+ * \param motor		The index of the motor.
+ * \param relative	The number of steps, negative values move backwards.
+ * \param interval	The time between two steps in Timebase ticks.
+ */
+void MotorTable::move(const uint8_t motor, const long relative, const uint16_t interval)
+{
+	const uint8_t channel = _hardwareChannels[motor];
+
+	if(channel != OutputCompareChannels::NO_CHANNEL)
+	{
+		// the direction is set before the channel starts, its first edge follows half an interval later
+		const boolean forward = relative > 0;
+
+		if(relative != 0 && forward != isForward(motor))
+		{
+			setDirection(motor, forward);
+		}
+
+		_outputCompareChannels->move(channel, relative, interval);
+		return;
+	}
+
+	_targetPositions[motor] += relative;
+	_intervals[motor] = interval;
+}
+
+
+/**
+ * \brief Overrides the position of a motor. A running motor keeps its remaining steps, the target moves by the same
+ *        offset.
+ * \param motor		The index of the motor.
+ * \param position	The new position in steps.
+ */
+void MotorTable::setPosition(const uint8_t motor, const long position)
+{
+	if(_hardwareChannels[motor] != OutputCompareChannels::NO_CHANNEL)
+	{
+		_outputCompareChannels->setPosition(_hardwareChannels[motor], position);
+		return;
+	}
+
+	shiftPosition(motor, position - _positions[motor]);
+}
+
+
+/**
+ * \brief Moves the position and the target of a motor by the same offset without stopping it.
+ * \param motor		The index of the motor.
+ * \param offset	The steps that are added to both.
+ */
+void MotorTable::shiftPosition(const uint8_t motor, const long offset)
+{
+	if(_hardwareChannels[motor] != OutputCompareChannels::NO_CHANNEL)
+	{
+		_outputCompareChannels->shiftPosition(_hardwareChannels[motor], offset);
+		return;
+	}
+
+	_positions[motor] += offset;
+	_targetPositions[motor] += offset;
+}
+
+
+long MotorTable::getPosition(const uint8_t motor) const
+{
+	if(_hardwareChannels[motor] != OutputCompareChannels::NO_CHANNEL)
+	{
+		return _outputCompareChannels->getPosition(_hardwareChannels[motor]);
+	}
+
+	return _positions[motor];
+}
+
+
+long MotorTable::getTargetPosition(const uint8_t motor) const
+{
+	if(_hardwareChannels[motor] != OutputCompareChannels::NO_CHANNEL)
+	{
+		return _outputCompareChannels->getTargetPosition(_hardwareChannels[motor]);
+	}
+
+	return _targetPositions[motor];
+}
+
+
+unsigned long MotorTable::getLastStepTime(const uint8_t motor) const
+{
+	if(_hardwareChannels[motor] != OutputCompareChannels::NO_CHANNEL)
+	{
+		return _outputCompareChannels->getLastStepTime(_hardwareChannels[motor]);
+	}
+
+	return _lastStepTimes[motor];
+}
+
+
+boolean MotorTable::isRunning(const uint8_t motor) const
+{
+	if(_hardwareChannels[motor] != OutputCompareChannels::NO_CHANNEL)
+	{
+		return _outputCompareChannels->isRunning(_hardwareChannels[motor]);
+	}
+
+	return _positions[motor] != _targetPositions[motor];
+}
+
+
+boolean MotorTable::isForward(const uint8_t motor) const
+{
+	return (_directions[motor / 8] & (1 << (motor % 8))) != 0;
+}
+
+
+void MotorTable::setDirection(const uint8_t motor, const boolean forward)
+{
+	const uint8_t oldSREG = SREG;
+	cli();
+
+	if(forward)
+	{
+		_directions[motor / 8] |= 1 << (motor % 8);
+		*_directionRegisters[motor] |= _directionBitMasks[motor];
+	}
+	else
+	{
+		_directions[motor / 8] &= ~(1 << (motor % 8));
+		*_directionRegisters[motor] &= ~_directionBitMasks[motor];
+	}
+
+	SREG = oldSREG;
+}
+
+
+uint8_t MotorTable::findStepPort(volatile uint8_t *stepRegister)
+{
+	for(uint8_t i = 0; i < _numberOfStepPorts; i++)
+	{
+		if(_stepPorts[i] == stepRegister)
+		{
+			return i;
+		}
+	}
+
+	_stepPorts[_numberOfStepPorts] = stepRegister;
+	_raisedStepMasks[_numberOfStepPorts] = 0;
+	return _numberOfStepPorts++;
+}
+
+
+void MotorTable::prepareStep(const uint8_t motor)
+{
+	const boolean forward = _targetPositions[motor] > _positions[motor];
+
+	// the direction pin is only written when it changes
+	if(forward != isForward(motor))
+	{
+		setDirection(motor, forward);
+	}
+
+	_positions[motor] += forward ? 1 : -1;
+}
+
+
+void MotorTable::setStepPins(const boolean isHigh)
+{
+	// the ports are shared with other pins, so the read-modify-writes must not be interrupted
+	const uint8_t oldSREG = SREG;
+	cli();
+
+	for(uint8_t i = 0; i < _numberOfStepPorts; i++)
+	{
+		if(isHigh)
+		{
+			*_stepPorts[i] |= _raisedStepMasks[i];
+		}
+		else
+		{
+			*_stepPorts[i] &= ~_raisedStepMasks[i];
+			_raisedStepMasks[i] = 0;
+		}
+	}
+
+	SREG = oldSREG;
+}
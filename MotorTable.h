@@ -0,0 +1,66 @@
+#ifndef MOTOR_TABLE_H
+#define MOTOR_TABLE_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "OutputCompareChannels.h"
+#include "Timebase.h"
+
+
+
+/**
+ * Holds the state of all step/dir motors as structure of arrays. The step loop only walks the hot arrays
+ * (positions, step times, intervals and directions), the port data is touched only when a motor steps.
+ * Motors on output compare pins are handed to the hardware channels, the step loop never sees them running.
+ */
+class MotorTable
+{
+public:
+	/* Methods */
+	void useOutputCompareChannels(OutputCompareChannels &outputCompareChannels);
+	void begin(const uint8_t motor, const uint8_t stepPin, const uint8_t directionPin);
+	void run();
+	void move(const uint8_t motor, const long relative, const uint16_t interval);
+	void setPosition(const uint8_t motor, const long position);
+	void shiftPosition(const uint8_t motor, const long offset);
+	long getPosition(const uint8_t motor) const;
+	long getTargetPosition(const uint8_t motor) const;
+	unsigned long getLastStepTime(const uint8_t motor) const;
+	boolean isRunning(const uint8_t motor) const;
+
+private:
+	/* Constants */
+	static const uint8_t MAX_PORTS = 11; // ports A to L of the ATmega2560
+	static const uint8_t DIRECTION_BYTES = (NUMBER_OF_STEPPERS + 7) / 8;
+
+	/* Variables */
+	// hot: read on every run
+	long _positions[NUMBER_OF_STEPPERS];
+	long _targetPositions[NUMBER_OF_STEPPERS];
+	unsigned long _scheduledStepTimes[NUMBER_OF_STEPPERS]; // Timebase ticks the last step was due
+	uint16_t _intervals[NUMBER_OF_STEPPERS]; // Timebase ticks between two steps
+	uint8_t _directions[DIRECTION_BYTES]; // one bit per motor, 1 = forward
+
+	// cold: only needed when a motor steps
+	unsigned long _lastStepTimes[NUMBER_OF_STEPPERS]; // Timebase ticks of the last rising step edge
+	uint8_t _stepPortIndices[NUMBER_OF_STEPPERS];
+	volatile uint8_t *_directionRegisters[NUMBER_OF_STEPPERS];
+	uint8_t _stepBitMasks[NUMBER_OF_STEPPERS];
+	uint8_t _directionBitMasks[NUMBER_OF_STEPPERS];
+	uint8_t _hardwareChannels[NUMBER_OF_STEPPERS]; // OutputCompareChannels::NO_CHANNEL = stepped in software
+	volatile uint8_t *_stepPorts[MAX_PORTS]; // output registers that have step pins
+	uint8_t _raisedStepMasks[MAX_PORTS]; // step pins that are high since the last run
+	uint8_t _numberOfStepPorts = 0;
+
+	/* Components */
+	OutputCompareChannels *_outputCompareChannels = nullptr;
+
+	/* Methods */
+	boolean isForward(const uint8_t motor) const;
+	void setDirection(const uint8_t motor, const boolean forward);
+	uint8_t findStepPort(volatile uint8_t *stepRegister);
+	void prepareStep(const uint8_t motor);
+	void setStepPins(const boolean isHigh);
+};
+
+#endif // MOTOR_TABLE_H
@@ -0,0 +1,96 @@
+#include "Arduino.h"
+#include "MovePlanner.h"
+
+
+/**
+ * \brief Assigns the links that are moved.
+ * \param links	The links of the endoscope.
+ */
+MovePlanner::MovePlanner(Link *links) : _links(links)
+{}
+
+
+/**
+ * \brief Plans the move to a pose and starts it. The float math happens here once, the step commands only use the
+ *        planned intervals.
+ * \param positions		The target positions of all steppers in steps, ordered by link and tendon.
+ * \param speedLimit	Steps per second no tendon exceeds, 0 = the max speed of every link.
+ */
+void MovePlanner::start(const long positions[], const float speedLimit)
+{
+	float duration = 0;
+
+	for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+	{
+		_targetPositions[i] = positions[i];
+	}
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		duration = max(duration, _links[i].getMinMoveDuration(&_targetPositions[i * STEPPERS_PER_LINK], speedLimit));
+	}
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		const uint8_t offset = i * STEPPERS_PER_LINK;
+		_links[i].planMovementsToPositions(&_targetPositions[offset], duration, speedLimit, &_intervals[offset]);
+	}
+
+	_plannedDuration = duration * 1000;
+	_isMoving = true;
+}
+
+
+/**
+ * \brief Stops the move. Already started steps are still finished.
+ */
+void MovePlanner::stop()
+{
+	_isMoving = false;
+}
+
+
+boolean MovePlanner::isMoving() const
+{
+	return _isMoving;
+}
+
+
+/**
+ * \brief Sets the movements towards the pose and finishes the move when all steppers have arrived. Has to be
+ *        called before the links are updated.
+ */
+void MovePlanner::update()
+{
+	if(!_isMoving)
+	{
+		return;
+	}
+
+	boolean hasReachedPose = true;
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		const uint8_t offset = i * STEPPERS_PER_LINK;
+
+		if(!_links[i].setMovementsToPositions(&_targetPositions[offset], &_intervals[offset]))
+		{
+			hasReachedPose = false;
+		}
+	}
+
+	if(hasReachedPose)
+	{
+		_isMoving = false;
+	}
+}
+
+
+/**
+ * \brief The duration the current or last move was planned with.
+ * \return The duration in milliseconds.
+ */
+unsigned long MovePlanner::getPlannedDuration() const
+{
+	return _plannedDuration;
+}
@@ -0,0 +1,39 @@
+#ifndef MOVE_PLANNER_H
+#define MOVE_PLANNER_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "Link.h"
+
+
+
+/**
+ * Moves all steppers of the endoscope to a pose so that they arrive at the same time. The duration is the shortest
+ * one the slowest tendon allows within the speed and acceleration limits of its link, the other tendons are slowed
+ * down to it.
+ */
+class MovePlanner
+{
+public:
+	/* Constructors */
+	MovePlanner(Link *links);
+
+	/* Methods */
+	void start(const long positions[], const float speedLimit);
+	void stop();
+	boolean isMoving() const;
+	void update();
+	unsigned long getPlannedDuration() const;
+
+private:
+	/* Variables */
+	boolean _isMoving = false;
+	unsigned long _plannedDuration = 0; // milliseconds the current move was planned with
+	long _targetPositions[NUMBER_OF_STEPPERS];
+	uint16_t _intervals[NUMBER_OF_STEPPERS]; // Timebase ticks between two steps
+
+	/* Components */
+	Link *_links;
+};
+
+#endif // MOVE_PLANNER_H
@@ -0,0 +1,448 @@
+#include "Arduino.h"
+#include "OutputCompareChannels.h"
+
+
+// the output compare pins of the channels A, B and C of Timer1, 3, 4 and 5
+const uint8_t OUTPUT_COMPARE_PINS[OutputCompareChannels::NUMBER_OF_HARDWARE_CHANNELS] PROGMEM =
+{
+	11, 12, 13, 5, 2, 3, 6, 7, 8, 46, 45, 44
+};
+
+OutputCompareChannels *OutputCompareChannels::_instance = nullptr;
+
+
+OutputCompareChannels::OutputCompareChannels()
+{
+	for(uint8_t i = 0; i < NUMBER_OF_HARDWARE_CHANNELS; i++)
+	{
+		_channelIndices[i] = NO_CHANNEL;
+	}
+}
+
+
+/**
+ * \brief Takes over the step pin of a motor if it is an output compare pin and a channel is left. The timer of the
+ *        pin is switched to normal mode with prescaler 8, PWM on its other pins is no longer available.
+ * \param stepPin	The digital pin that receives the step pulses, it has to be an output already.
+ * \return The allocated channel or NO_CHANNEL if the pulses have to be generated in software.
+ */
+uint8_t OutputCompareChannels::allocate(const uint8_t stepPin)
+{
+	const uint8_t hardwareChannel = findHardwareChannel(stepPin);
+
+	if(hardwareChannel == NO_CHANNEL || _channelIndices[hardwareChannel] != NO_CHANNEL ||
+	   _numberOfChannels >= MAX_HARDWARE_STEP_CHANNELS)
+	{
+		return NO_CHANNEL;
+	}
+
+	_instance = this;
+
+	const uint8_t channel = _numberOfChannels;
+	beginChannel(_channels[channel], hardwareChannel);
+	_channelIndices[hardwareChannel] = channel;
+	_numberOfChannels++;
+	return channel;
+}
+
+
+/**
+ * \brief Moves the target of a channel relative to its current target. A running channel takes the command at the
+ *        end of its pulse and goes on without stopping. A stopped channel steps one interval after its last step,
+ *        or as soon as the direction pin had its setup time if that is already over.
+ * \param channel	The allocated channel.
+ * \param relative	The number of steps, negative values move backwards.
+ * \param interval	The time between two steps in ticks.
+ */
+void OutputCompareChannels::move(const uint8_t channel, const long relative, const uint16_t interval)
+{
+	if(relative == 0)
+	{
+		return;
+	}
+
+	Channel &c = _channels[channel];
+	publishCommand(c, getTargetPosition(channel) + relative, max(interval / 2, MIN_HALF_INTERVAL));
+
+	// a running channel takes the command at its next falling edge. The command is published before the state is
+	// read, so a channel that stops in between is seen as stopped and started here
+	if(!c.isRunning)
+	{
+		start(c);
+	}
+}
+
+
+/**
+ * \brief Overrides the position of a channel. A running channel keeps running, its target moves by the same
+ *        offset, so re-basing the position never cancels a step.
+ * \param channel	The allocated channel.
+ * \param position	The new position in steps.
+ */
+void OutputCompareChannels::setPosition(const uint8_t channel, const long position)
+{
+	const uint8_t oldSREG = SREG;
+	cli();
+	shiftPosition(channel, position - _channels[channel].position);
+	SREG = oldSREG;
+}
+
+
+/**
+ * \brief Moves the position and the target of a channel by the same offset without stopping it.
+ * \param channel	The allocated channel.
+ * \param offset	The steps that are added to both.
+ */
+void OutputCompareChannels::shiftPosition(const uint8_t channel, const long offset)
+{
+	Channel &c = _channels[channel];
+	const uint8_t oldSREG = SREG;
+	cli();
+
+	// a command that is not taken yet is taken here, so its target is moved as well
+	takeCommand(c);
+	c.position += offset;
+	c.positionSequence++;
+	publishCommand(c, c.targetPosition + offset, c.halfInterval);
+	takeCommand(c);
+	SREG = oldSREG;
+}
+
+
+long OutputCompareChannels::getPosition(const uint8_t channel) const
+{
+	const Channel &c = _channels[channel];
+	uint8_t sequence;
+	long position;
+
+	// the interrupt cannot be interrupted by the loop, so a changed sequence is all that marks a torn read
+	do
+	{
+		sequence = c.positionSequence;
+		position = c.position;
+	}
+	while(sequence != c.positionSequence);
+
+	return position;
+}
+
+
+/**
+ * \brief The target of the last command, it is written by the loop only.
+ * \param channel	The allocated channel.
+ * \return The target position in steps.
+ */
+long OutputCompareChannels::getTargetPosition(const uint8_t channel) const
+{
+	const Channel &c = _channels[channel];
+	return c.commands[c.commandSequence & 1].targetPosition;
+}
+
+
+unsigned long OutputCompareChannels::getLastStepTime(const uint8_t channel) const
+{
+	const Channel &c = _channels[channel];
+	uint8_t sequence;
+	unsigned long lastStepTime;
+
+	do
+	{
+		sequence = c.positionSequence;
+		lastStepTime = c.lastStepTime;
+	}
+	while(sequence != c.positionSequence);
+
+	return lastStepTime;
+}
+
+
+/**
+ * \brief Indicates whether a channel still generates pulses. It runs until the falling edge of its last step.
+ * \param channel	The allocated channel.
+ * \return true = running
+ */
+boolean OutputCompareChannels::isRunning(const uint8_t channel) const
+{
+	return _channels[channel].isRunning;
+}
+
+
+/**
+ * \brief Called by the compare interrupts.
+ * \param hardwareChannel	The index of the channel in OUTPUT_COMPARE_PINS.
+ */
+void OutputCompareChannels::handleCompareMatch(const uint8_t hardwareChannel)
+{
+	if(_instance == nullptr)
+	{
+		return;
+	}
+
+	const uint8_t channel = _instance->_channelIndices[hardwareChannel];
+
+	if(channel != NO_CHANNEL)
+	{
+		_instance->handleChannel(_instance->_channels[channel]);
+	}
+}
+
+
+uint8_t OutputCompareChannels::findHardwareChannel(const uint8_t stepPin) const
+{
+	for(uint8_t i = 0; i < NUMBER_OF_HARDWARE_CHANNELS; i++)
+	{
+		if(pgm_read_byte(&OUTPUT_COMPARE_PINS[i]) == stepPin)
+		{
+			return i;
+		}
+	}
+
+	return NO_CHANNEL;
+}
+
+
+void OutputCompareChannels::beginChannel(Channel &channel, const uint8_t hardwareChannel)
+{
+	const uint8_t timer = hardwareChannel / 3;
+	const uint8_t timerChannel = hardwareChannel % 3;
+	volatile uint8_t *controlRegisterB;
+	volatile uint16_t *compareRegisterA;
+
+	// the register layout of the four 16 bit timers is the same
+	switch(timer)
+	{
+		case 0:
+			channel.controlRegister = &TCCR1A;
+			controlRegisterB = &TCCR1B;
+			channel.forceRegister = &TCCR1C;
+			channel.interruptMaskRegister = &TIMSK1;
+			channel.interruptFlagRegister = &TIFR1;
+			channel.counterRegister = &TCNT1;
+			compareRegisterA = &OCR1A;
+			break;
+		case 1:
+			channel.controlRegister = &TCCR3A;
+			controlRegisterB = &TCCR3B;
+			channel.forceRegister = &TCCR3C;
+			channel.interruptMaskRegister = &TIMSK3;
+			channel.interruptFlagRegister = &TIFR3;
+			channel.counterRegister = &TCNT3;
+			compareRegisterA = &OCR3A;
+			break;
+		case 2:
+			channel.controlRegister = &TCCR4A;
+			controlRegisterB = &TCCR4B;
+			channel.forceRegister = &TCCR4C;
+			channel.interruptMaskRegister = &TIMSK4;
+			channel.interruptFlagRegister = &TIFR4;
+			channel.counterRegister = &TCNT4;
+			compareRegisterA = &OCR4A;
+			break;
+		default:
+			channel.controlRegister = &TCCR5A;
+			controlRegisterB = &TCCR5B;
+			channel.forceRegister = &TCCR5C;
+			channel.interruptMaskRegister = &TIMSK5;
+			channel.interruptFlagRegister = &TIFR5;
+			channel.counterRegister = &TCNT5;
+			compareRegisterA = &OCR5A;
+			break;
+	}
+
+	channel.compareRegister = compareRegisterA + timerChannel;
+	channel.toggleMode = _BV(COM1A0) >> (2 * timerChannel);
+	channel.interruptBit = _BV(OCIE1A) << timerChannel;
+	channel.forceBit = _BV(FOC1A) >> timerChannel;
+	channel.position = 0;
+	channel.targetPosition = 0;
+	channel.lastStepTime = 0;
+	channel.positionSequence = 0;
+	channel.halfInterval = MIN_HALF_INTERVAL;
+	channel.commands[0].targetPosition = 0;
+	channel.commands[0].halfInterval = MIN_HALF_INTERVAL;
+	channel.commandSequence = 0;
+	channel.takenCommandSequence = 0;
+
+	const uint8_t oldSREG = SREG;
+	cli();
+
+	// the Arduino core starts the timers in 8 bit PWM mode with prescaler 64
+	if(*controlRegisterB != _BV(CS11))
+	{
+		*channel.controlRegister = 0;
+		*controlRegisterB = _BV(CS11);
+	}
+
+	stop(channel);
+	SREG = oldSREG;
+}
+
+
+// single writer: the other buffer than the published one is filled, the sequence is a single byte and switches
+// atomically to it. The interrupt only reads the published buffer and cannot be interrupted by the loop
+void OutputCompareChannels::publishCommand(Channel &channel, const long targetPosition, const uint16_t halfInterval)
+{
+	const uint8_t sequence = channel.commandSequence + 1;
+	Command &command = channel.commands[sequence & 1];
+	command.targetPosition = targetPosition;
+	command.halfInterval = halfInterval;
+	channel.commandSequence = sequence;
+}
+
+
+// called by the interrupt or with interrupts disabled
+void OutputCompareChannels::takeCommand(Channel &channel)
+{
+	const uint8_t sequence = channel.commandSequence;
+
+	if(sequence == channel.takenCommandSequence)
+	{
+		return;
+	}
+
+	const Command &command = channel.commands[sequence & 1];
+	channel.targetPosition = command.targetPosition;
+	channel.halfInterval = command.halfInterval;
+	channel.takenCommandSequence = sequence;
+}
+
+
+// the timer registers are shared with the interrupts of the other channels, so starting needs a short lock
+void OutputCompareChannels::start(Channel &channel)
+{
+	const uint8_t oldSREG = SREG;
+	cli();
+
+	// the interrupt may have taken the command before it stopped
+	takeCommand(channel);
+
+	if(!channel.isRunning && channel.position != channel.targetPosition)
+	{
+		// the step follows the last one after a whole interval like on a running channel, the latency of the
+		// command does not stretch the interval
+		const unsigned long elapsed = Timebase::getTicks() - channel.lastStepTime;
+		const unsigned long interval = 2UL * channel.halfInterval;
+		const uint16_t delay = elapsed < interval - MIN_START_DELAY ? interval - elapsed : MIN_START_DELAY;
+
+		channel.isRunning = true;
+		channel.isHigh = false;
+		*channel.compareRegister = *channel.counterRegister + delay;
+		*channel.interruptFlagRegister = channel.interruptBit; // a pending match is cleared by writing one
+		*channel.controlRegister = (*channel.controlRegister & ~(channel.toggleMode << 1)) | channel.toggleMode;
+		*channel.interruptMaskRegister |= channel.interruptBit;
+	}
+
+	SREG = oldSREG;
+}
+
+
+// interrupts have to be disabled
+void OutputCompareChannels::stop(Channel &channel)
+{
+	*channel.interruptMaskRegister &= ~channel.interruptBit;
+	*channel.controlRegister = (*channel.controlRegister & ~channel.toggleMode) | (channel.toggleMode << 1);
+	*channel.forceRegister = channel.forceBit; // clears the pin in case a pulse was high
+	channel.isRunning = false;
+	channel.isHigh = false;
+}
+
+
+void OutputCompareChannels::handleChannel(Channel &channel)
+{
+	// the pin was toggled by the hardware already
+	channel.isHigh = !channel.isHigh;
+
+	if(channel.isHigh)
+	{
+		// the edge happened at the match, the interrupt latency is taken off
+		const unsigned long now = Timebase::getTicks();
+		channel.position += channel.targetPosition > channel.position ? 1 : -1;
+		channel.lastStepTime = now - static_cast<uint16_t>(*channel.counterRegister - *channel.compareRegister);
+		channel.positionSequence++;
+	}
+	else
+	{
+		// new commands are taken while the pin is low, so a pulse is never cut short
+		takeCommand(channel);
+
+		if(channel.position == channel.targetPosition)
+		{
+			stop(channel);
+			return;
+		}
+	}
+
+	*channel.compareRegister += channel.halfInterval;
+}
+
+
+ISR(TIMER1_COMPA_vect)
+{
+	OutputCompareChannels::handleCompareMatch(0);
+}
+
+
+ISR(TIMER1_COMPB_vect)
+{
+	OutputCompareChannels::handleCompareMatch(1);
+}
+
+
+ISR(TIMER1_COMPC_vect)
+{
+	OutputCompareChannels::handleCompareMatch(2);
+}
+
+
+ISR(TIMER3_COMPA_vect)
+{
+	OutputCompareChannels::handleCompareMatch(3);
+}
+
+
+ISR(TIMER3_COMPB_vect)
+{
+	OutputCompareChannels::handleCompareMatch(4);
+}
+
+
+ISR(TIMER3_COMPC_vect)
+{
+	OutputCompareChannels::handleCompareMatch(5);
+}
+
+
+ISR(TIMER4_COMPA_vect)
+{
+	OutputCompareChannels::handleCompareMatch(6);
+}
+
+
+ISR(TIMER4_COMPB_vect)
+{
+	OutputCompareChannels::handleCompareMatch(7);
+}
+
+
+ISR(TIMER4_COMPC_vect)
+{
+	OutputCompareChannels::handleCompareMatch(8);
+}
+
+
+ISR(TIMER5_COMPA_vect)
+{
+	OutputCompareChannels::handleCompareMatch(9);
+}
+
+
+ISR(TIMER5_COMPB_vect)
+{
+	OutputCompareChannels::handleCompareMatch(10);
+}
+
+
+ISR(TIMER5_COMPC_vect)
+{
+	OutputCompareChannels::handleCompareMatch(11);
+}
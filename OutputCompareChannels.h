@@ -0,0 +1,94 @@
+#ifndef OUTPUT_COMPARE_CHANNELS_H
+#define OUTPUT_COMPARE_CHANNELS_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "Timebase.h"
+
+
+
+/**
+ * Generates the step pulses of motors whose step pin is an output compare pin of Timer1, 3, 4 or 5. The timers run
+ * free at 0.5 microseconds per tick like the Timebase. The pin toggles in hardware on every compare match and the compare interrupt
+ * reloads the next match, so the edges have no software jitter. Every rising edge is one step.
+ * The loop hands commands to the interrupt through a double buffered mailbox and reads the positions back with a
+ * sequence counter, so neither side has to disable interrupts while a channel is running.
+ */
+class OutputCompareChannels
+{
+public:
+	/* Constants */
+	static const uint8_t NO_CHANNEL = 0xFF;
+	static const uint8_t NUMBER_OF_HARDWARE_CHANNELS = 12; // channels A, B and C of Timer1, 3, 4 and 5
+
+	/* Constructors */
+	OutputCompareChannels();
+
+	/* Methods */
+	uint8_t allocate(const uint8_t stepPin);
+	void move(const uint8_t channel, const long relative, const uint16_t interval);
+	void setPosition(const uint8_t channel, const long position);
+	void shiftPosition(const uint8_t channel, const long offset);
+	long getPosition(const uint8_t channel) const;
+	long getTargetPosition(const uint8_t channel) const;
+	unsigned long getLastStepTime(const uint8_t channel) const;
+	boolean isRunning(const uint8_t channel) const;
+	static void handleCompareMatch(const uint8_t hardwareChannel);
+
+private:
+	/* Types */
+	struct Command
+	{
+		long targetPosition; // steps
+		uint16_t halfInterval; // ticks between two edges
+	};
+
+	struct Channel
+	{
+		volatile uint16_t *compareRegister; // OCRnx
+		volatile uint8_t *controlRegister; // TCCRnA, holds the compare output mode
+		volatile uint8_t *interruptMaskRegister; // TIMSKn
+		volatile uint8_t *interruptFlagRegister; // TIFRn
+		volatile uint8_t *forceRegister; // TCCRnC
+		volatile uint16_t *counterRegister; // TCNTn
+		uint8_t toggleMode; // COMnx0, the clear mode is the next higher bit
+		uint8_t interruptBit; // OCIEnx and OCFnx
+		uint8_t forceBit; // FOCnx
+
+		// written by the loop, the published buffer is selected by the lowest bit of the sequence
+		Command commands[2];
+		volatile uint8_t commandSequence;
+
+		// written by the interrupt, the loop only writes them with interrupts off
+		uint8_t takenCommandSequence;
+		long targetPosition; // steps
+		uint16_t halfInterval; // ticks between two edges
+		volatile long position; // steps
+		volatile unsigned long lastStepTime; // Timebase ticks of the last rising edge
+		volatile uint8_t positionSequence; // changes whenever the position or the step time changes
+		volatile boolean isRunning;
+		boolean isHigh;
+	};
+
+	/* Constants */
+	const uint16_t MIN_HALF_INTERVAL = 40; // ticks, leaves the interrupt enough time to reload
+	const uint16_t MIN_START_DELAY = 40; // ticks from the start to the first edge, covers the direction setup time
+
+	/* Variables */
+	Channel _channels[MAX_HARDWARE_STEP_CHANNELS];
+	uint8_t _numberOfChannels = 0;
+	uint8_t _channelIndices[NUMBER_OF_HARDWARE_CHANNELS]; // allocated channel of every hardware channel
+
+	static OutputCompareChannels *_instance; // receives the compare interrupts
+
+	/* Methods */
+	uint8_t findHardwareChannel(const uint8_t stepPin) const;
+	void beginChannel(Channel &channel, const uint8_t hardwareChannel);
+	void publishCommand(Channel &channel, const long targetPosition, const uint16_t halfInterval);
+	void takeCommand(Channel &channel);
+	void start(Channel &channel);
+	void stop(Channel &channel);
+	void handleChannel(Channel &channel);
+};
+
+#endif // OUTPUT_COMPARE_CHANNELS_H
@@ -0,0 +1,411 @@
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "ParameterTable.h"
+
+
+const char NAME_SPEED_SLOW[] PROGMEM = "slow";
+const char NAME_SPEED_FAST[] PROGMEM = "fast";
+const char NAME_POS_NEG_SPEED_FACTOR[] PROGMEM = "factor";
+const char NAME_MAX_POSITION[] PROGMEM = "maxpos";
+const char NAME_MAX_SPEED[] PROGMEM = "maxspeed";
+const char NAME_DECELERATION[] PROGMEM = "decel";
+const char NAME_ACCELERATION[] PROGMEM = "accel";
+const char NAME_JERK[] PROGMEM = "jerk";
+const char NAME_TAKE_UP_SPEED[] PROGMEM = "takeup";
+
+// in the order of the members of MotionParameters
+const char *const PARAMETER_NAMES[ParameterTable::NUMBER_OF_PARAMETERS] PROGMEM =
+{
+	NAME_SPEED_SLOW, NAME_SPEED_FAST, NAME_POS_NEG_SPEED_FACTOR, NAME_MAX_POSITION, NAME_MAX_SPEED,
+	NAME_DECELERATION, NAME_ACCELERATION, NAME_JERK, NAME_TAKE_UP_SPEED
+};
+
+// min and max in the order of the members of MotionParameters. The keyframes store positions as int16 and the
+// S-curve is integrated in 32 bit fixed point, which limits the max position, the speeds and the acceleration. The
+// lower limits of the acceleration and the jerk keep the ramp to 2000 steps per second within the entries of the
+// ramp table, a lower acceleration would never reach the max speed
+const float PARAMETER_RANGES[ParameterTable::NUMBER_OF_PARAMETERS][2] PROGMEM =
+{
+	{ 1, 2000 }, // slow
+	{ 1, 2000 }, // fast
+	{ 1, 4 }, // factor
+	{ 1, 32767 }, // maxpos
+	{ 1, 2000 }, // maxspeed
+	{ 100, 40000 }, // decel
+	{ 1000, 40000 }, // accel
+	{ 1000, 1000000 }, // jerk
+	{ 1, 2000 } // takeup
+};
+
+
+/**
+ * \brief Loads the parameters from the EEPROM or uses the defaults if nothing valid is stored.
+ */
+void ParameterTable::begin()
+{
+	if(!load())
+	{
+		restoreDefaults();
+	}
+}
+
+
+/**
+ * \brief Looks up a parameter by its name.
+ * \param name	The name that is used on the serial interface.
+ * \return The index of the parameter or NUMBER_OF_PARAMETERS if the name is unknown.
+ */
+uint8_t ParameterTable::findParameter(const char *name) const
+{
+	for(uint8_t i = 0; i < NUMBER_OF_PARAMETERS; i++)
+	{
+		if(strcmp_P(name, getName(i)) == 0)
+		{
+			return i;
+		}
+	}
+
+	return NUMBER_OF_PARAMETERS;
+}
+
+
+/**
+ * \brief The name of a parameter.
+ * \param parameter	The index of the parameter.
+ * \return The name in the program memory.
+ */
+PGM_P ParameterTable::getName(const uint8_t parameter) const
+{
+	return reinterpret_cast<PGM_P>(pgm_read_word(&PARAMETER_NAMES[parameter]));
+}
+
+
+/**
+ * \brief The current value of a parameter of a link.
+ * \param link		The index of the link.
+ * \param parameter	The index of the parameter.
+ * \return The value, the max position is converted to float.
+ */
+float ParameterTable::getValue(const uint8_t link, const uint8_t parameter) const
+{
+	return getLinkValue(_parameters[link], parameter);
+}
+
+
+float ParameterTable::getMinValue(const uint8_t parameter) const
+{
+	return pgm_read_float(&PARAMETER_RANGES[parameter][0]);
+}
+
+
+float ParameterTable::getMaxValue(const uint8_t parameter) const
+{
+	return pgm_read_float(&PARAMETER_RANGES[parameter][1]);
+}
+
+
+/**
+ * \brief Changes a parameter of one or all links. The change is pending until the links take it over.
+ * \param link		The index of the link or ALL_LINKS.
+ * \param parameter	The index of the parameter.
+ * \param value		The new value within the range of the parameter, the jerk may be 0 as well. The speeds have
+ *					to stay in the order slow <= fast <= maxspeed.
+ * \return true = value changed, false = invalid link, parameter or value; no link is changed then
+ */
+boolean ParameterTable::setValue(const uint8_t link, const uint8_t parameter, const float value)
+{
+	// the range is checked first, the max position would not even be converted correctly
+	if(parameter >= NUMBER_OF_PARAMETERS || (link >= NUMBER_OF_LINKS && link != ALL_LINKS) ||
+	   !isInRange(parameter, value))
+	{
+		return false;
+	}
+
+	// all links are checked before any of them is changed
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		if(link == ALL_LINKS || link == i)
+		{
+			MotionParameters changedParameters = _parameters[i];
+			setLinkValue(changedParameters, parameter, value);
+
+			if(!isValid(changedParameters))
+			{
+				return false;
+			}
+		}
+	}
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		if(link == ALL_LINKS || link == i)
+		{
+			setLinkValue(_parameters[i], parameter, value);
+		}
+	}
+
+	markChanged();
+	return true;
+}
+
+
+/**
+ * \brief The parameters of a link.
+ * \param link	The index of the link.
+ * \return The parameters that the link has to use.
+ */
+const MotionParameters &ParameterTable::getLinkParameters(const uint8_t link) const
+{
+	return _parameters[link];
+}
+
+
+/**
+ * \brief Sets all links back to the compiled default parameters. The EEPROM stays unchanged.
+ */
+void ParameterTable::restoreDefaults()
+{
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		_parameters[i] = DEFAULT_MOTION_PARAMETERS;
+	}
+
+	markChanged();
+}
+
+
+/**
+ * \brief Reads the parameters from the EEPROM.
+ * \return true = parameters loaded, false = nothing stored, stored with another layout, corrupted or out of range
+ */
+boolean ParameterTable::load()
+{
+	uint16_t address = EEPROM_START_ADDRESS;
+	uint16_t magicNumber = 0;
+	EEPROM.get(address, magicNumber);
+	address += sizeof(uint16_t);
+
+	if(magicNumber != MAGIC_NUMBER || EEPROM.read(address) != VERSION)
+	{
+		return false;
+	}
+
+	const uint8_t checksum = EEPROM.read(address + 1);
+	address += 2;
+
+	MotionParameters storedParameters[NUMBER_OF_LINKS];
+	EEPROM.get(address, storedParameters);
+
+	if(calculateChecksum(storedParameters) != checksum)
+	{
+		return false;
+	}
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		if(!isValid(storedParameters[i]))
+		{
+			return false;
+		}
+	}
+
+	memcpy(_parameters, storedParameters, sizeof(_parameters));
+	markChanged();
+	return true;
+}
+
+
+/**
+ * \brief Starts writing the parameters of all links to the EEPROM. The bytes are written one at a time by
+ *        continueSave(), an EEPROM write takes 3.3 ms and would stall the steppers if they followed each other.
+ *        A save that is running starts over.
+ */
+void ParameterTable::save()
+{
+	_isSaving = true;
+	_savedBytes = 0;
+}
+
+
+/**
+ * \brief Writes the next byte of a running save once the EEPROM has finished the previous one. Only changed bytes
+ *        are written. The version is cleared first and written last, so an interrupted save is never loaded; a
+ *        change of the parameters starts the save over.
+ * \return true = save still running, false = saved or no save started
+ */
+boolean ParameterTable::continueSave()
+{
+	if(!_isSaving)
+	{
+		return false;
+	}
+
+	if(!eeprom_is_ready())
+	{
+		return true;
+	}
+
+	const uint16_t versionAddress = EEPROM_START_ADDRESS + sizeof(uint16_t);
+	const uint16_t parametersAddress = EEPROM_START_ADDRESS + HEADER_SIZE;
+
+	if(_savedBytes == 0)
+	{
+		EEPROM.update(versionAddress, INVALID_VERSION);
+	}
+	else if(_savedBytes <= sizeof(_parameters))
+	{
+		const uint16_t i = _savedBytes - 1;
+		EEPROM.update(parametersAddress + i, reinterpret_cast<const uint8_t *>(_parameters)[i]);
+	}
+	else if(_savedBytes == sizeof(_parameters) + 1)
+	{
+		EEPROM.update(versionAddress + 1, calculateChecksum(_parameters));
+	}
+	else if(_savedBytes < sizeof(_parameters) + 2 + sizeof(uint16_t))
+	{
+		const uint8_t i = _savedBytes - sizeof(_parameters) - 2;
+		EEPROM.update(EEPROM_START_ADDRESS + i, reinterpret_cast<const uint8_t *>(&MAGIC_NUMBER)[i]);
+	}
+	else
+	{
+		EEPROM.update(versionAddress, VERSION);
+	}
+
+	_savedBytes++;
+	_isSaving = _savedBytes < SAVE_STEPS;
+	return _isSaving;
+}
+
+
+boolean ParameterTable::isSaving() const
+{
+	return _isSaving;
+}
+
+
+/**
+ * \brief Indicates whether parameters were changed since the links took them over.
+ * \return true = the links have to be updated
+ */
+boolean ParameterTable::hasPendingChanges() const
+{
+	return _hasPendingChanges;
+}
+
+
+/**
+ * \brief Marks the changed parameters as taken over by the links.
+ */
+void ParameterTable::clearPendingChanges()
+{
+	_hasPendingChanges = false;
+}
+
+
+float ParameterTable::getLinkValue(const MotionParameters &parameters, const uint8_t parameter) const
+{
+	switch(parameter)
+	{
+		case 0:
+			return parameters.speedSlow;
+		case 1:
+			return parameters.speedFast;
+		case 2:
+			return parameters.posNegSpeedFactor;
+		case 3:
+			return parameters.maxPosition;
+		case 4:
+			return parameters.maxSpeed;
+		case 5:
+			return parameters.deceleration;
+		case 6:
+			return parameters.acceleration;
+		case 7:
+			return parameters.jerk;
+		default:
+			return parameters.takeUpSpeed;
+	}
+}
+
+
+void ParameterTable::setLinkValue(MotionParameters &parameters, const uint8_t parameter, const float value)
+{
+	switch(parameter)
+	{
+		case 0:
+			parameters.speedSlow = value;
+			break;
+		case 1:
+			parameters.speedFast = value;
+			break;
+		case 2:
+			parameters.posNegSpeedFactor = value;
+			break;
+		case 3:
+			parameters.maxPosition = value;
+			break;
+		case 4:
+			parameters.maxSpeed = value;
+			break;
+		case 5:
+			parameters.deceleration = value;
+			break;
+		case 6:
+			parameters.acceleration = value;
+			break;
+		case 7:
+			parameters.jerk = value;
+			break;
+		default:
+			parameters.takeUpSpeed = value;
+			break;
+	}
+}
+
+
+boolean ParameterTable::isInRange(const uint8_t parameter, const float value) const
+{
+	// written as a positive check, so a corrupted value that is not a number fails as well
+	return (value >= getMinValue(parameter) && value <= getMaxValue(parameter)) ||
+	       (parameter == JERK_PARAMETER && value == 0);
+}
+
+
+boolean ParameterTable::isValid(const MotionParameters &parameters) const
+{
+	for(uint8_t i = 0; i < NUMBER_OF_PARAMETERS; i++)
+	{
+		if(!isInRange(i, getLinkValue(parameters, i)))
+		{
+			return false;
+		}
+	}
+
+	return parameters.speedSlow <= parameters.speedFast && parameters.speedFast <= parameters.maxSpeed;
+}
+
+
+uint8_t ParameterTable::calculateChecksum(const MotionParameters *parameters) const
+{
+	const uint8_t *bytes = reinterpret_cast<const uint8_t *>(parameters);
+	uint8_t checksum = 0;
+
+	for(uint16_t i = 0; i < NUMBER_OF_LINKS * sizeof(MotionParameters); i++)
+	{
+		checksum = (checksum << 1 | checksum >> 7) ^ bytes[i];
+	}
+
+	return checksum;
+}
+
+
+// the links take the change over between two control cycles, a running save writes the new values
+void ParameterTable::markChanged()
+{
+	_hasPendingChanges = true;
+
+	if(_isSaving)
+	{
+		_savedBytes = 0;
+	}
+}
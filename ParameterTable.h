@@ -0,0 +1,64 @@
+#ifndef PARAMETER_TABLE_H
+#define PARAMETER_TABLE_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "MotionParameters.h"
+
+
+
+/**
+ * Holds the motion parameters of every link and stores them in the EEPROM. Changed values are only marked as
+ * pending, the sketch hands them to the links between two control cycles. Every parameter has a range, and the
+ * speeds have to keep slow <= fast <= maxspeed; values outside are rejected, stored ones included.
+ */
+class ParameterTable
+{
+public:
+	/* Constants */
+	static const uint8_t NUMBER_OF_PARAMETERS = 9;
+	static const uint8_t ALL_LINKS = 0xFF;
+
+	/* Methods */
+	void begin();
+	uint8_t findParameter(const char *name) const;
+	PGM_P getName(const uint8_t parameter) const;
+	float getValue(const uint8_t link, const uint8_t parameter) const;
+	float getMinValue(const uint8_t parameter) const;
+	float getMaxValue(const uint8_t parameter) const;
+	boolean setValue(const uint8_t link, const uint8_t parameter, const float value);
+	const MotionParameters &getLinkParameters(const uint8_t link) const;
+	void restoreDefaults();
+	boolean load();
+	void save();
+	boolean continueSave();
+	boolean isSaving() const;
+	boolean hasPendingChanges() const;
+	void clearPendingChanges();
+
+private:
+	/* Constants */
+	static const uint8_t JERK_PARAMETER = 7; // may be 0 below its range, which selects the trapezoidal ramp
+	const uint16_t EEPROM_START_ADDRESS = EEPROM_PARAMETERS_ADDRESS;
+	static const uint8_t HEADER_SIZE = 4; // magic number, version and checksum in front of the parameters
+	static const uint16_t SAVE_STEPS = NUMBER_OF_LINKS * sizeof(MotionParameters) + HEADER_SIZE + 1;
+	const uint16_t MAGIC_NUMBER = 0x4D50; // marks an initialized parameter memory
+	const uint8_t VERSION = 5; // has to be increased when the layout of MotionParameters changes
+	const uint8_t INVALID_VERSION = 0; // marks a save in progress
+
+	/* Variables */
+	MotionParameters _parameters[NUMBER_OF_LINKS];
+	boolean _hasPendingChanges = false;
+	boolean _isSaving = false;
+	uint16_t _savedBytes = 0; // of the running save, SAVE_STEPS in total
+
+	/* Methods */
+	float getLinkValue(const MotionParameters &parameters, const uint8_t parameter) const;
+	void setLinkValue(MotionParameters &parameters, const uint8_t parameter, const float value);
+	boolean isInRange(const uint8_t parameter, const float value) const;
+	boolean isValid(const MotionParameters &parameters) const;
+	uint8_t calculateChecksum(const MotionParameters *parameters) const;
+	void markChanged();
+};
+
+#endif // PARAMETER_TABLE_H
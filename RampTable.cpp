@@ -0,0 +1,267 @@
+#include "Arduino.h"
+#include "RampTable.h"
+
+
+/**
+ * \brief Recomputes the ramp of the link.
+ * \param parameters	The motion parameters of the link.
+ */
+void RampTable::build(const MotionParameters &parameters)
+{
+	if(parameters.jerk > 0)
+	{
+		buildSCurve(parameters);
+	}
+	else
+	{
+		buildTrapezoid(parameters);
+	}
+}
+
+
+/**
+ * \brief Limits the commanded interval of the next step to the ramp. A slower command moves the step back along
+ *        the ramp so that a later faster command accelerates again; past the end of the ramp the step stays at
+ *        its end.
+ * \param interval	The commanded Timebase ticks between the previous and the next step.
+ * \param step		The steps taken since the start of the movement, moved back or held at the end of the ramp.
+ * \return The interval the step has to use.
+ */
+uint16_t RampTable::limitInterval(const uint16_t interval, uint16_t &step) const
+{
+	if(_length == 0)
+	{
+		return interval;
+	}
+
+	const uint8_t lastEntry = _length - 1;
+	const uint16_t rampSteps = getFirstStep(lastEntry);
+
+	if(step >= rampSteps)
+	{
+		// the max speed is reached, a slower command moves the step back
+		step = lastEntry > 0 && interval > _intervals[lastEntry - 1] ? getFirstStep(lastEntry - 1) : rampSteps;
+		return max(interval, _intervals[lastEntry]);
+	}
+
+	const uint8_t entry = getEntry(step);
+	const uint16_t rampInterval = getRampInterval(entry, step);
+
+	if(interval < rampInterval)
+	{
+		return rampInterval;
+	}
+
+	if(entry > 0 && interval > _intervals[entry - 1])
+	{
+		step = getFirstStep(entry - 1);
+	}
+
+	return interval;
+}
+
+
+/**
+ * \brief The interval of a step of the ramp. Read backwards it brakes: the step that leaves step - 1 steps to the
+ *        target takes this interval.
+ * \param step	The steps since the start of the ramp.
+ * \return The Timebase ticks before the step, the interval of the max speed past the end, 0 without a ramp.
+ */
+uint16_t RampTable::getInterval(const uint16_t step) const
+{
+	if(_length == 0)
+	{
+		return 0;
+	}
+
+	const uint8_t lastEntry = _length - 1;
+
+	if(step >= getFirstStep(lastEntry))
+	{
+		return _intervals[lastEntry];
+	}
+
+	return getRampInterval(getEntry(step), step);
+}
+
+
+uint8_t RampTable::getEntry(const uint16_t step) const
+{
+	if(step < FINE_STEPS)
+	{
+		return step;
+	}
+
+	return FINE_STEPS + ((step - FINE_STEPS) >> _shift);
+}
+
+
+uint16_t RampTable::getFirstStep(const uint8_t entry) const
+{
+	if(entry < FINE_STEPS)
+	{
+		return entry;
+	}
+
+	return FINE_STEPS + (static_cast<uint16_t>(entry - FINE_STEPS) << _shift);
+}
+
+
+// the interval falls convexly with the step, so the straight line between two entries stays on the slow side
+uint16_t RampTable::getRampInterval(const uint8_t entry, const uint16_t step) const
+{
+	const uint16_t offset = step - getFirstStep(entry);
+
+	if(offset == 0)
+	{
+		return _intervals[entry];
+	}
+
+	const unsigned long difference = _intervals[entry] - _intervals[entry + 1];
+	return _intervals[entry] - static_cast<uint16_t>((difference * offset) >> _shift);
+}
+
+
+void RampTable::calculateShift(const float rampSteps)
+{
+	_shift = 0;
+
+	while(_shift < MAX_SHIFT &&
+	      rampSteps > FINE_STEPS + (static_cast<unsigned long>(MAX_LENGTH - 1 - FINE_STEPS) << _shift))
+	{
+		_shift++;
+	}
+}
+
+
+// the exact equations of AVR446: the step n is reached at t = sqrt(2n / a), so the interval before it is the
+// difference to t(n - 1). The first step of a movement only waits if the motor stepped just before, it gets the
+// interval of the second. That one has the correction factor 0.676 that AVR446 uses for c0
+void RampTable::buildTrapezoid(const MotionParameters &parameters)
+{
+	const float acceleration = parameters.acceleration;
+	const float minInterval = Timebase::TICKS_PER_SECOND / parameters.maxSpeed;
+	calculateShift(parameters.maxSpeed * parameters.maxSpeed / (2 * acceleration));
+	_length = 0;
+
+	while(_length < MAX_LENGTH)
+	{
+		const float step = max(getFirstStep(_length), 1);
+		float interval = Timebase::TICKS_PER_SECOND * (sqrt(2 * step / acceleration) -
+		                                               sqrt(2 * (step - 1) / acceleration));
+
+		if(step == 1)
+		{
+			interval *= 0.676;
+		}
+
+		_intervals[_length] = min(max(interval, minInterval), 65535.0);
+		_length++;
+
+		if(interval <= minInterval)
+		{
+			break;
+		}
+	}
+}
+
+
+// integrates jerk, acceleration, velocity and position in fixed point. The time step is the longest that still
+// gives the ramp MAX_TIME_STEPS / 2 of them, at most 1/1024 seconds, so long ramps at a low acceleration build as
+// fast as short ones. The acceleration rises with the jerk up to its limit and falls early enough to reach zero at
+// the max speed; the position moves with the mean velocity of the time step. Only the first step of each entry and
+// the step before it get the time they are reached, interpolated within their time step, an entry gets the time
+// since the step before
+void RampTable::buildSCurve(const MotionParameters &parameters)
+{
+	// limited so that the fixed point values fit into 32 bit
+	const float maxSpeed = min(parameters.maxSpeed, 2000.0);
+	const float jerk = parameters.jerk;
+
+	// a low jerk does not reach the max acceleration, the acceleration then peaks at sqrt(v * j)
+	const float peakAcceleration = min(min(parameters.acceleration, 40000.0), sqrt(maxSpeed * jerk));
+	const float rampTime = maxSpeed / peakAcceleration + peakAcceleration / jerk;
+	calculateShift(maxSpeed * rampTime / 2);
+	uint8_t timeStepShift = MAX_TIME_STEP_SHIFT;
+
+	while(timeStepShift > 0 && rampTime * (1UL << timeStepShift) > MAX_TIME_STEPS / 2)
+	{
+		timeStepShift--;
+	}
+
+	const unsigned long timeStep = Timebase::TICKS_PER_SECOND >> timeStepShift;
+	const long wholeStep = 1L << VELOCITY_SHIFT;
+	const uint8_t accelerationShift = VELOCITY_SHIFT - timeStepShift;
+	const long maxAcceleration = peakAcceleration * (1UL << accelerationShift);
+	const long jerkStep = min(jerk * (1UL << accelerationShift) / (1UL << timeStepShift),
+	                          static_cast<float>(maxAcceleration));
+	const unsigned long doubleJerk = 2 * static_cast<unsigned long>(jerk);
+	const long wholeMaxSpeed = maxSpeed;
+	const unsigned long maxVelocity = static_cast<unsigned long>(wholeMaxSpeed) << VELOCITY_SHIFT;
+	long acceleration = 0; // velocity gained per time step, 20 fraction bits
+	unsigned long velocity = 0; // steps per second, 20 fraction bits
+	long fraction = 0; // of the step in progress, 20 fraction bits
+	uint16_t step = 0; // the last step reached, the first one at time 0
+	uint16_t timedStep = 0; // the last step that got a time
+	unsigned long time = 0; // Timebase ticks at the start of the time step
+	unsigned long stepTime = 0; // Timebase ticks when the timed step was reached
+	uint16_t timeSteps = 0;
+	_length = 0;
+
+	while(_length < MAX_LENGTH - 1 && velocity < maxVelocity && timeSteps < MAX_TIME_STEPS)
+	{
+		// the velocity that is still gained when the acceleration is brought back to zero is a^2 / (2j)
+		const unsigned long wholeAcceleration = (acceleration >> accelerationShift);
+		const long missingSpeed = wholeMaxSpeed - static_cast<long>(velocity >> VELOCITY_SHIFT);
+
+		if(missingSpeed <= 0 || wholeAcceleration * wholeAcceleration >= doubleJerk * missingSpeed)
+		{
+			acceleration = max(acceleration - jerkStep, jerkStep);
+		}
+		else
+		{
+			acceleration = min(acceleration + jerkStep, maxAcceleration);
+		}
+
+		const unsigned long previousVelocity = velocity;
+		velocity += acceleration;
+		const long distance = ((previousVelocity >> 1) + (velocity >> 1)) >> timeStepShift;
+		const uint16_t reachedStep = step + ((fraction + distance) >> VELOCITY_SHIFT);
+
+		// the position moves linearly within the time step
+		while(_length < MAX_LENGTH - 1)
+		{
+			const uint16_t entryStep = max(getFirstStep(_length), 1);
+			const uint16_t nextStep = timedStep + 1 < entryStep ? entryStep - 1 : entryStep;
+
+			if(nextStep > reachedStep)
+			{
+				break;
+			}
+
+			const long boundary = static_cast<long>(nextStep - step) << VELOCITY_SHIFT;
+			const unsigned long reachedTime = time + static_cast<unsigned long>(static_cast<float>(timeStep) *
+			                                                                     (boundary - fraction) / distance);
+
+			// the first step of a movement gets the interval of the second like on the trapezoid
+			while(nextStep == entryStep && _length < MAX_LENGTH - 1 && max(getFirstStep(_length), 1) == entryStep)
+			{
+				const unsigned long interval = min(reachedTime - stepTime, 65535UL);
+				_intervals[_length] = _length > 0 ? min(interval, _intervals[_length - 1]) : interval;
+				_length++;
+			}
+
+			timedStep = nextStep;
+			stepTime = reachedTime;
+		}
+
+		step = reachedStep;
+		fraction = (fraction + distance) & (wholeStep - 1);
+		time += timeStep;
+		timeSteps++;
+	}
+
+	// the last entry holds the max speed
+	_intervals[_length] = min(Timebase::TICKS_PER_SECOND / wholeMaxSpeed, 65535UL);
+	_length++;
+}
@@ -0,0 +1,51 @@
+#ifndef RAMP_TABLE_H
+#define RAMP_TABLE_H
+
+#include "Arduino.h"
+#include "MotionParameters.h"
+#include "Timebase.h"
+
+
+
+/**
+ * Step intervals of an acceleration from standstill up to the max speed, precomputed when the parameters change.
+ * A stepper counts the steps it took since the start and limits its commanded interval to the entry of that step,
+ * so the ramp costs a few shifts and table loads per step. The speed changes fastest right after the start, so the
+ * first FINE_STEPS steps have an entry each; every further entry covers 2^shift steps, their intervals are
+ * interpolated linearly to the next entry. The last entry holds the interval of the max speed.
+ * With a jerk the table holds an S-curve, the acceleration then rises and falls smoothly instead of jumping.
+ */
+class RampTable
+{
+public:
+	/* Constants */
+	static const uint8_t MAX_LENGTH = 32;
+
+	/* Methods */
+	void build(const MotionParameters &parameters);
+	uint16_t limitInterval(const uint16_t interval, uint16_t &step) const;
+	uint16_t getInterval(const uint16_t step) const;
+
+private:
+	/* Constants */
+	static const uint8_t FINE_STEPS = 16; // steps at the start with an entry of their own
+	static const uint8_t MAX_SHIFT = 8; // ramps up to FINE_STEPS + (MAX_LENGTH - 1 - FINE_STEPS) * 256 steps
+	static const uint8_t MAX_TIME_STEP_SHIFT = 10; // the S-curve is integrated in steps of at most 1/1024 seconds
+	static const uint16_t MAX_TIME_STEPS = 512; // bounds the time the S-curve takes to build
+	static const uint8_t VELOCITY_SHIFT = 20; // fraction bits of the integrated velocity and position
+
+	/* Variables */
+	uint16_t _intervals[MAX_LENGTH]; // Timebase ticks before the first step of each entry, descending
+	uint8_t _length = 0;
+	uint8_t _shift = 0;
+
+	/* Methods */
+	uint8_t getEntry(const uint16_t step) const;
+	uint16_t getFirstStep(const uint8_t entry) const;
+	uint16_t getRampInterval(const uint8_t entry, const uint16_t step) const;
+	void calculateShift(const float rampSteps);
+	void buildTrapezoid(const MotionParameters &parameters);
+	void buildSCurve(const MotionParameters &parameters);
+};
+
+#endif // RAMP_TABLE_H
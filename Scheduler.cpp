@@ -0,0 +1,129 @@
+#include "Arduino.h"
+#include "Scheduler.h"
+
+
+/**
+ * \brief Adds a task. The order of adding is the priority of the periodic tasks.
+ * \param function	The function that is called.
+ * \param period	The time between two calls in microseconds, 0 = on every run.
+ * \return true = added, false = no free task slot
+ */
+boolean Scheduler::addTask(const TaskFunction function, const unsigned long period)
+{
+	if(_numberOfTasks >= MAX_TASKS)
+	{
+		return false;
+	}
+
+	Task &task = _tasks[_numberOfTasks];
+	task.function = function;
+	task.period = period;
+	task.nextRunTime = 0;
+	task.maxLateness = 0;
+	task.overruns = 0;
+	_numberOfTasks++;
+	return true;
+}
+
+
+/**
+ * \brief Runs all fast tasks and the first due periodic task. Has to be called as often as possible.
+ * \param now	The current time in microseconds.
+ */
+void Scheduler::run(const unsigned long now)
+{
+	if(!_isStarted)
+	{
+		start(now);
+	}
+
+	boolean hasRunPeriodicTask = false;
+
+	for(uint8_t i = 0; i < _numberOfTasks; i++)
+	{
+		Task &task = _tasks[i];
+
+		if(task.period == 0)
+		{
+			task.function();
+		}
+		else if(!hasRunPeriodicTask)
+		{
+			hasRunPeriodicTask = runIfDue(task, now);
+		}
+	}
+}
+
+
+uint8_t Scheduler::getNumberOfTasks() const
+{
+	return _numberOfTasks;
+}
+
+
+unsigned long Scheduler::getPeriod(const uint8_t task) const
+{
+	return _tasks[task].period;
+}
+
+
+uint16_t Scheduler::getOverruns(const uint8_t task) const
+{
+	return _tasks[task].overruns;
+}
+
+
+unsigned long Scheduler::getMaxLateness(const uint8_t task) const
+{
+	return _tasks[task].maxLateness;
+}
+
+
+void Scheduler::resetStatistics()
+{
+	for(uint8_t i = 0; i < _numberOfTasks; i++)
+	{
+		_tasks[i].maxLateness = 0;
+		_tasks[i].overruns = 0;
+	}
+}
+
+
+void Scheduler::start(const unsigned long now)
+{
+	for(uint8_t i = 0; i < _numberOfTasks; i++)
+	{
+		_tasks[i].nextRunTime = now;
+	}
+
+	_isStarted = true;
+}
+
+
+boolean Scheduler::runIfDue(Task &task, const unsigned long now)
+{
+	const unsigned long lateness = now - task.nextRunTime;
+
+	// the unsigned difference is huge while the due time is still ahead
+	if(lateness >= 0x80000000UL)
+	{
+		return false;
+	}
+
+	task.maxLateness = max(task.maxLateness, lateness);
+
+	if(lateness >= task.period)
+	{
+		// a whole period was missed: count it and realign instead of running the task several times in a row
+		task.overruns++;
+		task.nextRunTime = now + task.period;
+	}
+	else
+	{
+		// keep the rate fixed independent of the lateness
+		task.nextRunTime += task.period;
+	}
+
+	task.function();
+	return true;
+}
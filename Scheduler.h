@@ -0,0 +1,53 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "Arduino.h"
+
+
+
+/**
+ * Cooperative scheduler with fixed-rate tasks. Tasks with period 0 run on every call, periodic tasks run
+ * in the order they were added and at most one of them per call, so the fast tasks are never delayed by
+ * more than the slowest periodic task. The time is passed in, which keeps the scheduler independent of
+ * the clock source.
+ */
+class Scheduler
+{
+public:
+	/* Types */
+	typedef void (*TaskFunction)();
+
+	/* Methods */
+	boolean addTask(const TaskFunction function, const unsigned long period);
+	void run(const unsigned long now);
+	uint8_t getNumberOfTasks() const;
+	unsigned long getPeriod(const uint8_t task) const;
+	uint16_t getOverruns(const uint8_t task) const;
+	unsigned long getMaxLateness(const uint8_t task) const;
+	void resetStatistics();
+
+private:
+	/* Types */
+	struct Task
+	{
+		TaskFunction function;
+		unsigned long period; // microseconds, 0 = as often as possible
+		unsigned long nextRunTime;
+		unsigned long maxLateness; // microseconds the task started after its due time
+		uint16_t overruns; // number of periods that were skipped completely
+	};
+
+	/* Constants */
+	static const uint8_t MAX_TASKS = 12;
+
+	/* Variables */
+	Task _tasks[MAX_TASKS];
+	uint8_t _numberOfTasks = 0;
+	boolean _isStarted = false;
+
+	/* Methods */
+	void start(const unsigned long now);
+	boolean runIfDue(Task &task, const unsigned long now);
+};
+
+#endif // SCHEDULER_H
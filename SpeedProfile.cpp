@@ -0,0 +1,132 @@
+#include "SpeedProfile.h"
+
+
+/**
+ * \brief Recomputes the intervals from the parameters. The negative range uses the base speeds, the positive range
+ *        is faster by the speed factor because it is longer by the same factor.
+ * \param parameters		The motion parameters of the link.
+ * \param negMaxPosition	The negative end position in steps.
+ */
+void SpeedProfile::build(const MotionParameters &parameters, const long negMaxPosition)
+{
+	_numberOfRegions = 0;
+	addRegion(0, parameters, 1, 1);
+	addRegion(0, parameters, parameters.posNegSpeedFactor, parameters.posNegSpeedFactor);
+
+	_minInterval = convertToInterval(parameters.maxSpeed, parameters.maxSpeed);
+	_takeUpInterval = convertToInterval(parameters.takeUpSpeed, parameters.maxSpeed);
+	_maxPosition = parameters.maxPosition;
+	_negMaxPosition = negMaxPosition;
+	buildEnvelope(parameters);
+}
+
+
+/**
+ * \brief Appends a region that starts at the given position and lasts up to the next region. Regions have to be
+ *        added in ascending order, the lower bound of the first region is ignored.
+ * \param lowerBound		The first position of the region in steps.
+ * \param parameters		The motion parameters of the link.
+ * \param forwardFactor		The factor the forward speeds are multiplied with in this region.
+ * \param backwardFactor	The factor the backward speeds are multiplied with in this region.
+ * \return true = region added, false = table full
+ */
+boolean SpeedProfile::addRegion(const long lowerBound, const MotionParameters &parameters, const float forwardFactor,
+                                const float backwardFactor)
+{
+	if(_numberOfRegions >= MAX_REGIONS)
+	{
+		return false;
+	}
+
+	uint16_t *intervals = _intervals[_numberOfRegions];
+	intervals[FORWARD_SLOW] = convertToInterval(parameters.speedSlow * forwardFactor, parameters.maxSpeed);
+	intervals[FORWARD_FAST] = convertToInterval(parameters.speedFast * forwardFactor, parameters.maxSpeed);
+	intervals[BACKWARD_SLOW] = convertToInterval(parameters.speedSlow * backwardFactor, parameters.maxSpeed);
+	intervals[BACKWARD_FAST] = convertToInterval(parameters.speedFast * backwardFactor, parameters.maxSpeed);
+
+	_lowerBounds[_numberOfRegions] = lowerBound;
+	_numberOfRegions++;
+	return true;
+}
+
+
+/**
+ * \brief The step interval of a movement at a position, stretched by the deceleration envelope.
+ * \param position	The current position of the tendon in steps.
+ * \param movement	FORWARD_SLOW, FORWARD_FAST, BACKWARD_SLOW or BACKWARD_FAST
+ * \return The Timebase ticks between two steps.
+ */
+uint16_t SpeedProfile::getInterval(const long position, const uint8_t movement) const
+{
+	uint8_t region = 0;
+
+	while(region + 1 < _numberOfRegions && position >= _lowerBounds[region + 1])
+	{
+		region++;
+	}
+
+	return max(_intervals[region][movement], getEnvelopeInterval(position, movement < BACKWARD_SLOW));
+}
+
+
+/**
+ * \brief The shortest interval the deceleration envelope allows in front of the end position a tendon heads to.
+ * \param position	The current position of the tendon in steps.
+ * \param isForward	true = towards the max position, false = towards the negative end position
+ * \return The Timebase ticks between two steps, the one of the max speed outside the envelope.
+ */
+uint16_t SpeedProfile::getEnvelopeInterval(const long position, const boolean isForward) const
+{
+	const long distance = isForward ? _maxPosition - position : position - _negMaxPosition;
+
+	for(uint8_t i = 0; i < ENVELOPE_STEPS; i++)
+	{
+		if(distance < _envelopeDistances[i])
+		{
+			return _envelopeIntervals[i];
+		}
+	}
+
+	return _minInterval;
+}
+
+
+uint16_t SpeedProfile::getMinInterval() const
+{
+	return _minInterval;
+}
+
+
+uint16_t SpeedProfile::getTakeUpInterval() const
+{
+	return _takeUpInterval;
+}
+
+
+/**
+ * \brief Divides the braking distance from the max speed down to the slow speed into equal steps. Within a step
+ *        the speed is limited to what a constant deceleration allows at its near end, v = sqrt(v_slow^2 + 2ad).
+ * \param parameters	The motion parameters of the link.
+ */
+void SpeedProfile::buildEnvelope(const MotionParameters &parameters)
+{
+	const float minSpeed = parameters.speedSlow;
+	const float maxSpeed = max(parameters.maxSpeed, minSpeed);
+	const float brakingDistance = (maxSpeed * maxSpeed - minSpeed * minSpeed) / (2 * parameters.deceleration);
+
+	for(uint8_t i = 0; i < ENVELOPE_STEPS; i++)
+	{
+		const float nearDistance = brakingDistance * i / ENVELOPE_STEPS;
+		_envelopeDistances[i] = ceil(brakingDistance * (i + 1) / ENVELOPE_STEPS);
+		_envelopeIntervals[i] = convertToInterval(sqrt(minSpeed * minSpeed + 2 * parameters.deceleration * nearDistance),
+		                                          parameters.maxSpeed);
+	}
+}
+
+
+uint16_t SpeedProfile::convertToInterval(const float speed, const float maxSpeed) const
+{
+	const float minSpeed = static_cast<float>(Timebase::TICKS_PER_SECOND) / 65535;
+	const float limitedSpeed = constrain(fabs(speed), minSpeed, maxSpeed);
+	return Timebase::TICKS_PER_SECOND / limitedSpeed;
+}
@@ -0,0 +1,53 @@
+#ifndef SPEED_PROFILE_H
+#define SPEED_PROFILE_H
+
+#include "Arduino.h"
+#include "MotionParameters.h"
+#include "Timebase.h"
+
+
+
+/**
+ * Step intervals of the tendons of a link, precomputed per position region and movement. A movement command only
+ * looks up its interval, the float math happens once when the parameters change. In front of the end positions
+ * the intervals are stretched so that the tendons decelerate instead of running into the limit at full speed.
+ */
+class SpeedProfile
+{
+public:
+	/* Constants */
+	static const uint8_t FORWARD_SLOW = 0;
+	static const uint8_t FORWARD_FAST = 1;
+	static const uint8_t BACKWARD_SLOW = 2;
+	static const uint8_t BACKWARD_FAST = 3;
+	static const uint8_t NUMBER_OF_MOVEMENTS = 4;
+	static const uint8_t MAX_REGIONS = 4;
+	static const uint8_t ENVELOPE_STEPS = 8;
+
+	/* Methods */
+	void build(const MotionParameters &parameters, const long negMaxPosition);
+	boolean addRegion(const long lowerBound, const MotionParameters &parameters, const float forwardFactor,
+	                  const float backwardFactor);
+	uint16_t getInterval(const long position, const uint8_t movement) const;
+	uint16_t getEnvelopeInterval(const long position, const boolean isForward) const;
+	uint16_t getMinInterval() const;
+	uint16_t getTakeUpInterval() const;
+
+private:
+	/* Variables */
+	uint8_t _numberOfRegions = 0;
+	long _lowerBounds[MAX_REGIONS]; // steps, the first region has no lower bound
+	uint16_t _intervals[MAX_REGIONS][NUMBER_OF_MOVEMENTS]; // Timebase ticks between two steps
+	uint16_t _minInterval = 0; // Timebase ticks between two steps at the max speed
+	uint16_t _takeUpInterval = 0; // Timebase ticks between two steps that take up slack
+	long _maxPosition = 0; // steps
+	long _negMaxPosition = 0; // steps
+	long _envelopeDistances[ENVELOPE_STEPS]; // steps to the end position, ascending
+	uint16_t _envelopeIntervals[ENVELOPE_STEPS]; // shortest interval allowed below the distance
+
+	/* Methods */
+	void buildEnvelope(const MotionParameters &parameters);
+	uint16_t convertToInterval(const float speed, const float maxSpeed) const;
+};
+
+#endif // SPEED_PROFILE_H
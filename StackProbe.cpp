@@ -0,0 +1,63 @@
+#include "Arduino.h"
+#include "StackProbe.h"
+
+
+extern uint8_t __data_start;
+extern uint8_t __heap_start;
+extern char *__brkval;
+
+
+/**
+ * \brief Fills the unused RAM with the pattern. Has to be called once at the beginning of setup().
+ */
+void StackProbe::paint() const
+{
+	uint8_t stackMarker;
+	uint8_t *address = getHeapEnd();
+
+	while(address < &stackMarker - SAFETY_MARGIN)
+	{
+		*address = PAINT_PATTERN;
+		address++;
+	}
+}
+
+
+/**
+ * \brief The number of bytes between heap and stack that have never been used since paint() was called.
+ * \return The stack headroom in bytes.
+ */
+uint16_t StackProbe::getUnusedStackBytes() const
+{
+	const uint8_t *address = getHeapEnd();
+	uint16_t unusedBytes = 0;
+
+	while(address <= reinterpret_cast<const uint8_t *>(RAMEND) && *address == PAINT_PATTERN)
+	{
+		unusedBytes++;
+		address++;
+	}
+
+	return unusedBytes;
+}
+
+
+/**
+ * \brief The RAM that is occupied by global and static variables (.data and .bss).
+ * \return The size in bytes.
+ */
+uint16_t StackProbe::getStaticRamBytes() const
+{
+	return &__heap_start - &__data_start;
+}
+
+
+uint8_t *StackProbe::getHeapEnd() const
+{
+	if(__brkval == nullptr)
+	{
+		return &__heap_start;
+	}
+
+	return reinterpret_cast<uint8_t *>(__brkval);
+}
@@ -0,0 +1,29 @@
+#ifndef STACK_PROBE_H
+#define STACK_PROBE_H
+
+#include "Arduino.h"
+
+
+
+/**
+ * Measures the stack high-water mark by painting the free RAM between heap and stack with a pattern
+ * and counting later how much of it is still untouched.
+ */
+class StackProbe
+{
+public:
+	/* Methods */
+	void paint() const;
+	uint16_t getUnusedStackBytes() const;
+	uint16_t getStaticRamBytes() const;
+
+private:
+	/* Constants */
+	static const uint8_t PAINT_PATTERN = 0xA5;
+	static const uint8_t SAFETY_MARGIN = 16; // bytes below the current stack frame that are left untouched
+
+	/* Methods */
+	uint8_t *getHeapEnd() const;
+};
+
+#endif // STACK_PROBE_H
@@ -1,69 +1,187 @@
 #include "Stepper.h"
 
 
-Stepper::Stepper(AccelStepper &stepper) : _stepper(stepper)
+void Stepper::begin(MotorTable &motorTable, const uint8_t motor, const TendonConfig &config, const RampTable &rampTable)
 {
-	_stepper.setMaxSpeed(MAX_SPEED);
-	setCurrentPosition(0);
+	_motorTable = &motorTable;
+	_rampTable = &rampTable;
+	_motor = motor;
+	_motorTable->begin(_motor, config.stepPin, config.directionPin);
 }
 
 
-void Stepper::step() const
+/**
+ * \brief Commands one step forward unless the previous step is still pending.
+ * \param interval	The Timebase ticks between the previous and this full step.
+ * \return true = step commanded, false = previous step not taken yet
+ */
+boolean Stepper::moveForward(const uint16_t interval)
 {
-	_stepper.runSpeedToPosition();
+	return move(1, interval);
 }
 
 
-boolean Stepper::setForwardMovement(const float speed) const
+/**
+ * \brief Commands one step backward unless the previous step is still pending.
+ * \param interval	The Timebase ticks between the previous and this full step.
+ * \return true = step commanded, false = previous step not taken yet
+ */
+boolean Stepper::moveBackward(const uint16_t interval)
 {
-	if(isRunning())
+	return move(-1, interval);
+}
+
+
+/**
+ * \brief Sets the position. The backlash offset and the last direction are cleared, the tendon counts as tight in
+ *        whichever direction it moves next. A running motor is not stopped; a running take-up is finished first and
+ *        the position applies to its end.
+ * \param position	The position in full steps.
+ */
+void Stepper::setCurrentPosition(const long position)
+{
+	const long oldTargetPosition = _motorTable->getTargetPosition(_motor);
+
+	if(_isTakingUp && isRunning())
 	{
-		return false;
+		_motorTable->shiftPosition(_motor, position * MICROSTEPS - _motorTable->getTargetPosition(_motor));
+	}
+	else
+	{
+		_isTakingUp = false;
+		_motorTable->setPosition(_motor, position * MICROSTEPS);
 	}
 
-	_stepper.move(1);
-	_stepper.setSpeed(speed);
-	return true;
+	// the ramp goes on with the steps taken so far
+	_rampStart += (_motorTable->getTargetPosition(_motor) - oldTargetPosition) / MICROSTEPS;
+	_backlashOffset = 0;
+	_lastDirection = 0;
+}
+
+
+/**
+ * \brief Sets the slack that is taken up after every reversal.
+ * \param backlash	The slack in full steps, 0 = no compensation.
+ */
+void Stepper::setBacklash(const uint8_t backlash)
+{
+	_backlash = backlash;
+}
+
+
+uint8_t Stepper::getBacklash() const
+{
+	return _backlash;
+}
+
+
+/**
+ * \brief Sets the speed the slack is taken up with. The tendon carries no load during the take-up, so it may be
+ *        faster than the start of the ramp.
+ * \param interval	The Timebase ticks between two take-up steps.
+ */
+void Stepper::setTakeUpInterval(const uint16_t interval)
+{
+	_takeUpInterval = interval;
 }
 
 
-boolean Stepper::setBackwardMovement(const float speed) const
+/**
+ * \brief The position without the take-up steps. While the slack is taken up the position stays at the reversal.
+ * \return The position in full steps.
+ */
+long Stepper::getCurrentPosition()
 {
-	if(isRunning())
+	if(_isTakingUp)
 	{
-		return false;
+		if(isRunning())
+		{
+			return getTargetPosition();
+		}
+
+		_isTakingUp = false;
 	}
 
-	_stepper.move(-1);
-	_stepper.setSpeed(speed);
-	return true;
+	return _motorTable->getPosition(_motor) / MICROSTEPS - _backlashOffset;
 }
 
 
-void Stepper::setCurrentPosition(const long position) const
+long Stepper::getTargetPosition()
 {
-	_stepper.setCurrentPosition(position);
+	return _motorTable->getTargetPosition(_motor) / MICROSTEPS - _backlashOffset;
 }
 
 
-long Stepper::getCurrentPosition() const
+unsigned long Stepper::getLastStepTime()
 {
-	return _stepper.currentPosition();
+	return _motorTable->getLastStepTime(_motor);
 }
 
 
-long Stepper::getTargetPosition() const
+bool Stepper::isRunning()
 {
-	return _stepper.targetPosition();
+	return _motorTable->isRunning(_motor);
 }
 
 
-bool Stepper::isRunning() const
+// the next step is queued as soon as the motor took the previous one, a hardware channel then goes on at the end of
+// the running pulse without stopping. A reversal waits until the pulse is over
+boolean Stepper::move(const int8_t direction, const uint16_t interval)
 {
-	if(_stepper.distanceToGo() != 0)
+	if(hasPendingSteps() || (direction != _lastDirection && isRunning()))
+	{
+		return false;
+	}
+
+	if(_backlash > 0 && _lastDirection != 0 && direction != _lastDirection)
+	{
+		return takeUp(direction);
+	}
+
+	// a reversal or a pause of more than two steps starts the ramp again. All commanded steps are taken here, so
+	// the target is the position
+	const uint16_t position = _motorTable->getTargetPosition(_motor) / MICROSTEPS;
+	const unsigned long pause = Timebase::getTicks() - getLastStepTime();
+
+	if(direction != _rampDirection || pause > 2UL * _lastInterval)
 	{
-		return true;
+		_rampStart = position;
 	}
 
-	return false;
+	// the ramp is indexed by the steps taken since its start, the table may move the start
+	uint16_t rampStep = direction > 0 ? position - _rampStart : _rampStart - position;
+	const uint16_t limitedInterval = _rampTable->limitInterval(interval, rampStep);
+	_rampStart = direction > 0 ? position - rampStep : position + rampStep;
+	_isTakingUp = false;
+	_lastDirection = direction;
+	_rampDirection = direction;
+	_lastInterval = limitedInterval;
+	_motorTable->move(_motor, direction * MICROSTEPS, limitedInterval / MICROSTEPS);
+	return true;
+}
+
+
+boolean Stepper::hasPendingSteps()
+{
+	return _motorTable->getTargetPosition(_motor) != _motorTable->getPosition(_motor);
+}
+
+
+/**
+ * \brief Takes up the slack after a reversal. The commanded step follows with the next command, which starts the
+ *        ramp because the load only starts to move once the tendon is tight.
+ * \param direction	The new direction.
+ * \return true = take-up commanded
+ */
+boolean Stepper::takeUp(const int8_t direction)
+{
+	_backlashOffset += direction * _backlash;
+	_isTakingUp = true;
+	_lastDirection = direction;
+	_lastInterval = _takeUpInterval;
+	_motorTable->move(_motor, direction * _backlash * MICROSTEPS, _takeUpInterval / MICROSTEPS);
+
+	// the ramp starts where the tendon is tight
+	_rampStart = _motorTable->getTargetPosition(_motor) / MICROSTEPS;
+	return true;
 }
@@ -1,31 +1,63 @@
 #ifndef STEPPER_H
 #define STEPPER_H
 
-#include "AccelStepper.h"
+#include "Arduino.h"
+#include "Configuration.h"
+#include "MotorTable.h"
+#include "RampTable.h"
 
 
 
+/**
+ * A tendon motor within the motor table. Positions and intervals are given in full steps, the stepper converts them
+ * to the microsteps of the driver. A stepper that starts from standstill accelerates along the ramp of its link.
+ * After a reversal the slack of the tendon is taken up first; these steps do not change the position.
+ */
 class Stepper
 {
 public:
-	/* Constructors */
-	Stepper(AccelStepper &stepper);
-
 	/* Methods */
-	void step() const;
-	boolean setForwardMovement(const float speed) const;
-	boolean setBackwardMovement(const float speed) const;
-	void setCurrentPosition(const long position) const;
-	long getCurrentPosition() const;
-	long getTargetPosition() const;
-	bool isRunning() const;
+	void begin(MotorTable &motorTable, const uint8_t motor, const TendonConfig &config, const RampTable &rampTable);
+	boolean moveForward(const uint16_t interval);
+	boolean moveBackward(const uint16_t interval);
+	void setCurrentPosition(const long position);
+	void setBacklash(const uint8_t backlash);
+	uint8_t getBacklash() const;
+	void setTakeUpInterval(const uint16_t interval);
+	long getCurrentPosition();
+	long getTargetPosition();
+	unsigned long getLastStepTime();
+	bool isRunning();
 
 private:
-	/* Constants */
-	const float MAX_SPEED = 750;
+	/* Variables */
+	uint8_t _motor = 0; // index of the motor within the motor table
+	uint16_t _rampStart = 0; // low word of the position the ramp started at, in full steps
+	uint16_t _lastInterval = 0; // Timebase ticks of the last command
+	int8_t _lastDirection = 0; // 1 = forward, -1 = backward, 0 = no take-up at the next command
+	int8_t _rampDirection = 0; // of the running ramp, kept when the position is set
+	uint8_t _backlash = 0; // full steps of slack that are taken up after a reversal
+	uint16_t _takeUpInterval = 0; // Timebase ticks between two take-up steps
+	int16_t _backlashOffset = 0; // full steps the motor is ahead of the position
+	boolean _isTakingUp = false;
+
+	/* Components */
+	MotorTable *_motorTable = nullptr;
+	const RampTable *_rampTable = nullptr;
 
-	/* References */
-	AccelStepper &_stepper;
+	/* Methods */
+	boolean move(const int8_t direction, const uint16_t interval);
+	boolean hasPendingSteps();
+	boolean takeUp(const int8_t direction);
 };
 
+// the RAM of a motor is its share of the motor table plus its stepper, a general purpose AccelStepper needed more
+// than 60 bytes. The hardware channels are not counted, there are only MAX_HARDWARE_STEP_CHANNELS of them
+constexpr size_t MOTOR_RAM_BUDGET = 48;
+
+#if defined(__AVR__)
+static_assert(sizeof(MotorTable) + NUMBER_OF_STEPPERS * sizeof(Stepper) <= NUMBER_OF_STEPPERS * MOTOR_RAM_BUDGET,
+	"the motor state exceeds MOTOR_RAM_BUDGET bytes per motor");
+#endif
+
 #endif // STEPPER_H
@@ -0,0 +1,61 @@
+#include "Arduino.h"
+#include "Timebase.h"
+
+
+volatile uint16_t Timebase::_overflows = 0;
+
+
+/**
+ * \brief Lets Timer1 run free with prescaler 8. The output compare channels of Timer1 use the same mode, so a timer
+ *        they set up already is left as it is.
+ */
+void Timebase::begin()
+{
+	const uint8_t oldSREG = SREG;
+	cli();
+
+	// the Arduino core starts the timer in 8 bit PWM mode with prescaler 64
+	if(TCCR1B != _BV(CS11))
+	{
+		TCCR1A = 0;
+		TCCR1B = _BV(CS11);
+	}
+
+	TIFR1 = _BV(TOV1);
+	TIMSK1 |= _BV(TOIE1);
+	SREG = oldSREG;
+}
+
+
+/**
+ * \brief The current time. Can be called with interrupts disabled and from interrupts.
+ * \return The ticks of 0.5 microseconds since the start.
+ */
+unsigned long Timebase::getTicks()
+{
+	const uint8_t oldSREG = SREG;
+	cli();
+	const uint16_t counter = TCNT1;
+	uint16_t overflows = _overflows;
+
+	// an overflow that happened while interrupts are disabled is not counted yet
+	if((TIFR1 & _BV(TOV1)) && counter < 0x8000)
+	{
+		overflows++;
+	}
+
+	SREG = oldSREG;
+	return (static_cast<unsigned long>(overflows) << 16) | counter;
+}
+
+
+void Timebase::handleOverflow()
+{
+	_overflows++;
+}
+
+
+ISR(TIMER1_OVF_vect)
+{
+	Timebase::handleOverflow();
+}
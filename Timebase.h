@@ -0,0 +1,30 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include "Arduino.h"
+
+
+
+/**
+ * Free running 0.5 microsecond clock of the step scheduler. Timer1 counts with prescaler 8 and its overflow
+ * interrupt extends the count to 32 bit, which lasts about 35 minutes before it wraps. Reading it costs less than
+ * micros() and resolves eight times finer.
+ */
+class Timebase
+{
+public:
+	/* Constants */
+	static const unsigned long TICKS_PER_SECOND = 2000000;
+	static const uint8_t TICKS_PER_MICROSECOND = 2;
+
+	/* Methods */
+	static void begin();
+	static unsigned long getTicks();
+	static void handleOverflow();
+
+private:
+	/* Variables */
+	static volatile uint16_t _overflows; // upper 16 bit of the tick count
+};
+
+#endif // TIMEBASE_H
@@ -0,0 +1,195 @@
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "Trajectory.h"
+
+
+/**
+ * \brief Assigns the links and loads the number of keyframes that are stored in the EEPROM.
+ * \param links	The links whose steppers are recorded and played back.
+ */
+Trajectory::Trajectory(Link *links) : _links(links), _movePlanner(links)
+{
+	loadNumberOfKeyframes();
+}
+
+
+/**
+ * \brief Deletes all recorded keyframes.
+ */
+void Trajectory::clear()
+{
+	stopPlayback();
+	_numberOfKeyframes = 0;
+	storeNumberOfKeyframes();
+}
+
+
+/**
+ * \brief Saves the current positions of all steppers as the next keyframe.
+ * \return true = keyframe saved, false = playback running or memory full
+ */
+boolean Trajectory::recordKeyframe()
+{
+	if(_isPlaying || _numberOfKeyframes >= getMaxNumberOfKeyframes())
+	{
+		return false;
+	}
+
+	long positions[STEPPERS_PER_LINK];
+	uint16_t address = getKeyframeAddress(_numberOfKeyframes);
+
+	for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+	{
+		_links[i].getStepperPositions(positions);
+
+		for(uint8_t j = 0; j < STEPPERS_PER_LINK; j++)
+		{
+			// the soft limits keep every position within 16 bit
+			const int16_t position = positions[j];
+			EEPROM.put(address, position);
+			address += sizeof(int16_t);
+		}
+	}
+
+	_numberOfKeyframes++;
+	storeNumberOfKeyframes();
+	return true;
+}
+
+
+/**
+ * \brief The number of recorded keyframes.
+ * \return The number of keyframes stored in the EEPROM.
+ */
+uint8_t Trajectory::getNumberOfKeyframes() const
+{
+	return _numberOfKeyframes;
+}
+
+
+/**
+ * \brief Starts to move the links along the recorded keyframes.
+ * \return true = playback started, false = nothing recorded
+ */
+boolean Trajectory::startPlayback()
+{
+	if(_numberOfKeyframes == 0)
+	{
+		return false;
+	}
+
+	_keyframeIndex = 0;
+	loadKeyframe(_keyframeIndex);
+	_isPlaying = true;
+	return true;
+}
+
+
+/**
+ * \brief Stops the playback. Already started steps are still finished.
+ */
+void Trajectory::stopPlayback()
+{
+	_movePlanner.stop();
+	_isPlaying = false;
+}
+
+
+/**
+ * \brief Indicates whether the recorded keyframes are played back.
+ * \return true = playing
+ */
+boolean Trajectory::isPlaying() const
+{
+	return _isPlaying;
+}
+
+
+/**
+ * \brief Sets the movements towards the current keyframe and switches to the next keyframe when all steppers have
+ *        arrived. Has to be called before the links are updated.
+ */
+void Trajectory::update()
+{
+	if(!_isPlaying)
+	{
+		return;
+	}
+
+	_movePlanner.update();
+
+	if(_movePlanner.isMoving())
+	{
+		return;
+	}
+
+	_keyframeIndex++;
+
+	if(_keyframeIndex >= _numberOfKeyframes)
+	{
+		_isPlaying = false;
+		return;
+	}
+
+	loadKeyframe(_keyframeIndex);
+}
+
+
+uint8_t Trajectory::getMaxNumberOfKeyframes() const
+{
+	const uint16_t freeBytes = EEPROM.length() - getKeyframeAddress(0);
+	return min(freeBytes / (NUMBER_OF_STEPPERS * sizeof(int16_t)), 255);
+}
+
+
+uint16_t Trajectory::getKeyframeAddress(const uint8_t keyframeIndex) const
+{
+	// header: magic number and number of keyframes
+	const uint16_t headerSize = sizeof(uint16_t) + sizeof(uint8_t);
+	return EEPROM_START_ADDRESS + headerSize + keyframeIndex * NUMBER_OF_STEPPERS * sizeof(int16_t);
+}
+
+
+void Trajectory::loadNumberOfKeyframes()
+{
+	uint16_t magicNumber;
+	EEPROM.get(EEPROM_START_ADDRESS, magicNumber);
+
+	if(magicNumber != MAGIC_NUMBER)
+	{
+		_numberOfKeyframes = 0;
+		return;
+	}
+
+	_numberOfKeyframes = EEPROM.read(EEPROM_START_ADDRESS + sizeof(uint16_t));
+
+	if(_numberOfKeyframes > getMaxNumberOfKeyframes())
+	{
+		_numberOfKeyframes = 0;
+	}
+}
+
+
+void Trajectory::storeNumberOfKeyframes() const
+{
+	EEPROM.put(EEPROM_START_ADDRESS, MAGIC_NUMBER);
+	EEPROM.update(EEPROM_START_ADDRESS + sizeof(uint16_t), _numberOfKeyframes);
+}
+
+
+void Trajectory::loadKeyframe(const uint8_t keyframeIndex)
+{
+	uint16_t address = getKeyframeAddress(keyframeIndex);
+	long positions[NUMBER_OF_STEPPERS];
+
+	for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+	{
+		int16_t position;
+		EEPROM.get(address, position);
+		address += sizeof(int16_t);
+		positions[i] = position;
+	}
+
+	// all steppers reach the keyframe at the same time
+	_movePlanner.start(positions, PLAYBACK_SPEED);
+}
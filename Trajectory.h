@@ -0,0 +1,49 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "Link.h"
+#include "MovePlanner.h"
+
+
+
+class Trajectory
+{
+public:
+	/* Constructors */
+	Trajectory(Link *links);
+
+	/* Methods */
+	void clear();
+	boolean recordKeyframe();
+	uint8_t getNumberOfKeyframes() const;
+	boolean startPlayback();
+	void stopPlayback();
+	boolean isPlaying() const;
+	void update();
+
+private:
+	/* Constants */
+	const uint16_t EEPROM_START_ADDRESS = EEPROM_TRAJECTORY_ADDRESS;
+	const uint16_t MAGIC_NUMBER = 0x454B; // marks an initialized trajectory memory
+	const float PLAYBACK_SPEED = 500; // steps per second
+
+	/* Variables */
+	uint8_t _numberOfKeyframes = 0;
+	uint8_t _keyframeIndex = 0;
+	boolean _isPlaying = false;
+
+	/* Components */
+	Link *_links;
+	MovePlanner _movePlanner;
+
+	/* Methods */
+	uint8_t getMaxNumberOfKeyframes() const;
+	uint16_t getKeyframeAddress(const uint8_t keyframeIndex) const;
+	void loadNumberOfKeyframes();
+	void storeNumberOfKeyframes() const;
+	void loadKeyframe(const uint8_t keyframeIndex);
+};
+
+#endif // TRAJECTORY_H
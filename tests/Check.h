@@ -0,0 +1,53 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+// Minimal assertions of the host tests: a failed check is printed and counted, finish() turns the count into the
+// exit code.
+#define CHECK(condition) Check::verify((condition), #condition, __FILE__, __LINE__)
+#define CHECK_EQUAL(expected, actual) \
+	Check::verifyEqual(static_cast<long long>(expected), static_cast<long long>(actual), #actual, __FILE__, __LINE__)
+
+
+class Check
+{
+public:
+	static bool verify(const bool condition, const char *text, const char *file, const int line)
+	{
+		if(!condition)
+		{
+			printf("%s:%d: check failed: %s\n", file, line, text);
+			failures()++;
+		}
+
+		return condition;
+	}
+
+	static bool verifyEqual(const long long expected, const long long actual, const char *text, const char *file,
+	                        const int line)
+	{
+		if(expected != actual)
+		{
+			printf("%s:%d: check failed: %s is %lld, expected %lld\n", file, line, text, actual, expected);
+			failures()++;
+		}
+
+		return expected == actual;
+	}
+
+	static int finish(const char *name)
+	{
+		printf("%s: %s\n", name, failures() == 0 ? "passed" : "FAILED");
+		return failures() == 0 ? 0 : 1;
+	}
+
+private:
+	static int &failures()
+	{
+		static int count = 0;
+		return count;
+	}
+};
+
+#endif // CHECK_H
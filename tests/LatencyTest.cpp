@@ -0,0 +1,119 @@
+#include "Arduino.h"
+#include "Check.h"
+#include "LatencyMonitor.h"
+#include "Link.h"
+#include "MotorTable.h"
+#include "Simulation.h"
+#include "Timebase.h"
+
+// Measures the latency from a joystick sample to the first step of the link in the order of the scheduler passes:
+// the step loop, the latency check and the movement commands of the sample. The link stands still for more than
+// 2^31 ticks before some of the deflections, an old step must not pass for the first step of the new movement.
+
+namespace
+{
+	const unsigned long LOOP_LATENCY = 200; // ticks between two passes of the loop
+	const uint8_t NUMBER_OF_DEFLECTIONS = 20;
+	const long STEPS_PER_DEFLECTION = 20;
+	const unsigned long SHORT_PAUSE = 100000; // ticks the joystick rests in the center
+	const unsigned long LONG_PAUSE = 0x8001; // periods of 65536 ticks, just over 2^31 ticks
+	const TendonConfig UP = { 22, 23, 24 };
+	const TendonConfig RIGHT = { 25, 26, 27 };
+	const TendonConfig DOWN = { 28, 29, 30 };
+	const TendonConfig LEFT = { 31, 32, 33 };
+	const LinkConfig CONFIG = { UP, RIGHT, DOWN, LEFT, A3, 0, NO_PIN, 0, 20 };
+
+	// static like in the sketch
+	MotorTable motorTable;
+	Link link;
+	LatencyMonitor latencyMonitor;
+
+
+	// the measureLatency() task of the sketch
+	void measureLatency()
+	{
+		unsigned long stepTime = 0;
+
+		if(latencyMonitor.isMeasuring() && link.hasSteppedSince(latencyMonitor.getStepTimes(), stepTime))
+		{
+			latencyMonitor.finishMeasurement(stepTime);
+		}
+	}
+
+
+	void printHistogram()
+	{
+		for(uint8_t i = 0; i < LatencyMonitor::NUMBER_OF_BUCKETS; i++)
+		{
+			printf("< %lu us: %u\n", latencyMonitor.getBucketLimit(i), latencyMonitor.getBucketCount(i));
+		}
+
+		printf("measurements %u, mean %lu us, max %lu us\n", latencyMonitor.getNumberOfMeasurements(),
+		       latencyMonitor.getMeanLatency(), latencyMonitor.getMaxLatency());
+	}
+
+
+	void testLatencyAfterLongPauses()
+	{
+		Simulation::reset();
+		Timebase::begin();
+		link.begin(CONFIG, motorTable, 0);
+		latencyMonitor.reset();
+		long target = 0;
+
+		// the barriers read as reached, so the tendons move backward only
+		for(uint8_t i = 0; i < NUMBER_OF_DEFLECTIONS; i++)
+		{
+			if(i % 2 == 0)
+			{
+				Simulation::skip(LONG_PAUSE);
+			}
+			else
+			{
+				Simulation::advance(SHORT_PAUSE);
+			}
+
+			const unsigned long sampleTime = Timebase::getTicks();
+			unsigned long stepTimes[STEPPERS_PER_LINK];
+			link.getLastStepTimes(stepTimes);
+			latencyMonitor.startMeasurement(0, sampleTime, stepTimes);
+
+			// an old step does not end the measurement before the movement is commanded
+			measureLatency();
+			CHECK(latencyMonitor.isMeasuring());
+
+			target -= STEPS_PER_DEFLECTION;
+			const long positions[STEPPERS_PER_LINK] = { target, target, target, target };
+			const uint16_t intervals[STEPPERS_PER_LINK] = { 2000, 2000, 2000, 2000 };
+
+			while(true)
+			{
+				motorTable.run();
+				measureLatency();
+
+				if(link.setMovementsToPositions(positions, intervals) && !link.isMoving())
+				{
+					break;
+				}
+
+				Simulation::advance(LOOP_LATENCY);
+			}
+
+			CHECK(!latencyMonitor.isMeasuring());
+		}
+
+		printHistogram();
+
+		// the first step follows the sample within the next pass of the loop
+		CHECK_EQUAL(NUMBER_OF_DEFLECTIONS, latencyMonitor.getNumberOfMeasurements());
+		CHECK_EQUAL(0, latencyMonitor.getNumberOfAborts());
+		CHECK(latencyMonitor.getMaxLatency() <= LOOP_LATENCY / Timebase::TICKS_PER_MICROSECOND);
+	}
+}
+
+
+int main()
+{
+	testLatencyAfterLongPauses();
+	return Check::finish("LatencyTest");
+}
@@ -0,0 +1,207 @@
+#include <signal.h>
+#include <sys/time.h>
+#include "Arduino.h"
+#include "Check.h"
+#include "MotorTable.h"
+#include "OutputCompareChannels.h"
+#include "RampTable.h"
+#include "Simulation.h"
+#include "Stepper.h"
+#include "Timebase.h"
+
+// Lets a signal stand in for the timer interrupts: the handler advances the simulated time by a random number of
+// ticks, so the compare interrupts preempt the loop at random points of the command and position code. cli() blocks
+// the signal like it blocks the interrupts on the chip. The loop drives a stepper on pin 45 back and forth with
+// changing intervals and re-bases it now and then; no step may be lost, doubled, cut short or go the wrong way.
+
+namespace
+{
+	const uint8_t STEP_PIN = 45;
+	const uint8_t DIRECTION_PIN = 47;
+	const uint8_t HARDWARE_CHANNEL = 10; // OC5B
+	const uint16_t INTERVALS[] = { 200, 300, 500, 1000 };
+	const uint8_t NUMBER_OF_INTERVALS = sizeof(INTERVALS) / sizeof(INTERVALS[0]);
+	const long NUMBER_OF_STEPS = 4000;
+	const uint8_t MAX_TICKS_PER_SIGNAL = 150;
+
+	volatile unsigned long forwardEdges = 0;
+	volatile unsigned long backwardEdges = 0;
+	volatile unsigned long fallingEdges = 0;
+	volatile unsigned long invalidPulses = 0;
+	volatile unsigned long shortSpacings = 0;
+	unsigned long lastRisingEdge = 0;
+	unsigned long random = 12345;
+
+	OutputCompareChannels channels;
+	MotorTable motorTable;
+	RampTable rampTable; // not built, the stepper starts at full speed
+	Stepper stepper;
+
+
+	// the signal handler must not call rand()
+	unsigned long nextRandom()
+	{
+		random = random * 1103515245UL + 12345UL;
+		return (random >> 16) & 0x7FFF;
+	}
+
+
+	boolean isHalfInterval(const unsigned long ticks)
+	{
+		for(uint16_t interval : INTERVALS)
+		{
+			if(ticks == interval / 2UL)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	void recordEdge(const uint8_t hardwareChannel, const uint8_t level, const unsigned long ticks)
+	{
+		if(hardwareChannel != HARDWARE_CHANNEL)
+		{
+			return;
+		}
+
+		if(level == LOW)
+		{
+			fallingEdges++;
+
+			// a pulse lasts half of one of the commanded intervals, a command never cuts it short
+			if(!isHalfInterval(ticks - lastRisingEdge))
+			{
+				invalidPulses++;
+			}
+
+			return;
+		}
+
+		// the driver latches the direction at the rising edge
+		if(PORT_OUTPUTS[digitalPinToPort(DIRECTION_PIN)] & digitalPinToBitMask(DIRECTION_PIN))
+		{
+			forwardEdges++;
+		}
+		else
+		{
+			backwardEdges++;
+		}
+
+		if(forwardEdges + backwardEdges > 1 && ticks - lastRisingEdge < INTERVALS[0])
+		{
+			shortSpacings++;
+		}
+
+		lastRisingEdge = ticks;
+	}
+
+
+	void armTimer()
+	{
+		itimerval timer = {};
+		timer.it_value.tv_usec = 5 + nextRandom() % 40;
+		setitimer(ITIMER_REAL, &timer, nullptr);
+	}
+
+
+	void handleSignal(int)
+	{
+		Simulation::advance(1 + nextRandom() % MAX_TICKS_PER_SIGNAL);
+		armTimer();
+	}
+
+
+	void startPreemption()
+	{
+		struct sigaction action = {};
+		action.sa_handler = handleSignal;
+		sigemptyset(&action.sa_mask);
+		sigaction(SIGALRM, &action, nullptr);
+		Simulation::setPreemptionSignal(SIGALRM);
+		armTimer();
+	}
+
+
+	void stopPreemption()
+	{
+		sigset_t signals;
+		sigemptyset(&signals);
+		sigaddset(&signals, SIGALRM);
+		sigprocmask(SIG_BLOCK, &signals, nullptr);
+		itimerval timer = {};
+		setitimer(ITIMER_REAL, &timer, nullptr);
+		Simulation::setPreemptionSignal(0);
+		sigprocmask(SIG_UNBLOCK, &signals, nullptr);
+	}
+
+
+	void testRandomPreemption()
+	{
+		Simulation::reset();
+		Simulation::setEdgeListener(recordEdge);
+		Timebase::begin();
+		motorTable.useOutputCompareChannels(channels);
+		const TendonConfig config = { STEP_PIN, DIRECTION_PIN, 0 };
+		stepper.begin(motorTable, 0, config, rampTable);
+
+		long commandedSteps = 0;
+		long commandedPosition = 0;
+		long rebaseOffset = 0;
+		int8_t direction = 1;
+		long stepsLeftInDirection = 1;
+		uint16_t interval = INTERVALS[0];
+		unsigned long passes = 0;
+		startPreemption();
+
+		while(commandedSteps < NUMBER_OF_STEPS)
+		{
+			passes++;
+
+			if(passes % 997 == 0)
+			{
+				motorTable.shiftPosition(0, 1000);
+				rebaseOffset += 1000;
+			}
+
+			if(stepsLeftInDirection == 0)
+			{
+				direction = -direction;
+				stepsLeftInDirection = 1 + nextRandom() % 50;
+				interval = INTERVALS[nextRandom() % NUMBER_OF_INTERVALS];
+			}
+
+			if(direction > 0 ? stepper.moveForward(interval) : stepper.moveBackward(interval))
+			{
+				commandedSteps++;
+				commandedPosition += direction;
+				stepsLeftInDirection--;
+			}
+		}
+
+		while(stepper.isRunning())
+		{
+			// the signal finishes the last steps
+		}
+
+		stopPreemption();
+
+		CHECK_EQUAL(NUMBER_OF_STEPS, forwardEdges + backwardEdges);
+		CHECK_EQUAL(forwardEdges + backwardEdges, fallingEdges);
+		CHECK_EQUAL(commandedPosition, static_cast<long>(forwardEdges - backwardEdges));
+		CHECK_EQUAL(commandedPosition + rebaseOffset, stepper.getCurrentPosition());
+		CHECK_EQUAL(0, invalidPulses);
+		CHECK_EQUAL(0, shortSpacings);
+		CHECK(rebaseOffset > 0);
+		CHECK_EQUAL(LOW, Simulation::getOutputCompareLevel(HARDWARE_CHANNEL));
+	}
+}
+
+
+int main()
+{
+	testRandomPreemption();
+	return Check::finish("MailboxStressTest");
+}
@@ -0,0 +1,34 @@
+#include "Arduino.h"
+#include "Check.h"
+#include "MotorTable.h"
+#include "Stepper.h"
+
+// Reports the RAM per motor. The AVR build checks MOTOR_RAM_BUDGET with a static_assert. On the host long and
+// pointers take 8 instead of 4 and 2 bytes, so the same layout needs about 1.8 times as much; the host limit
+// catches a growing motor state before it reaches the AVR build.
+
+namespace
+{
+	const size_t HOST_FACTOR_PERCENT = 200;
+
+
+	void testRamPerMotor()
+	{
+		const size_t tableShare = (sizeof(MotorTable) + NUMBER_OF_STEPPERS - 1) / NUMBER_OF_STEPPERS;
+		const size_t bytesPerMotor = tableShare + sizeof(Stepper);
+
+		printf("RAM per motor on the host: %u bytes (motor table %u, stepper %u), AVR budget %u bytes\n",
+		       static_cast<unsigned>(bytesPerMotor), static_cast<unsigned>(tableShare),
+		       static_cast<unsigned>(sizeof(Stepper)), static_cast<unsigned>(MOTOR_RAM_BUDGET));
+
+		CHECK(bytesPerMotor * 100 <= MOTOR_RAM_BUDGET * HOST_FACTOR_PERCENT);
+	}
+
+}
+
+
+int main()
+{
+	testRamPerMotor();
+	return Check::finish("MotorMemoryTest");
+}
@@ -0,0 +1,162 @@
+#include <math.h>
+#include "Arduino.h"
+#include "Check.h"
+#include "Link.h"
+#include "MotorTable.h"
+#include "MovePlanner.h"
+#include "Simulation.h"
+#include "Timebase.h"
+
+// Moves the tendons of the first link to a pose and records the time of every step. The tendons have to arrive
+// together after about the planned duration and must not be faster than the ramp allows, neither when they start
+// nor in front of their positions.
+
+namespace
+{
+	const unsigned long LOOP_LATENCY = 20; // ticks between two passes of the loop
+	const unsigned long MAX_TICKS = 20000000; // ten seconds
+	const uint16_t MAX_STEPS = 2000;
+
+	// static like in the sketch
+	MotorTable motorTable;
+	Link links[NUMBER_OF_LINKS];
+	MovePlanner movePlanner(links);
+	unsigned long stepTimes[STEPPERS_PER_LINK][MAX_STEPS];
+	uint16_t numberOfSteps[STEPPERS_PER_LINK];
+
+
+	void recordSteps()
+	{
+		for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+		{
+			const unsigned long stepTime = motorTable.getLastStepTime(i);
+
+			if(stepTime != 0 && (numberOfSteps[i] == 0 || stepTime != stepTimes[i][numberOfSteps[i] - 1]) &&
+			   numberOfSteps[i] < MAX_STEPS)
+			{
+				stepTimes[i][numberOfSteps[i]] = stepTime;
+				numberOfSteps[i]++;
+			}
+		}
+	}
+
+
+	void startLinks()
+	{
+		Simulation::reset();
+		Timebase::begin();
+
+		for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+		{
+			links[i].begin(LINK_CONFIGS[i], motorTable, i * STEPPERS_PER_LINK);
+		}
+
+		for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+		{
+			numberOfSteps[i] = 0;
+		}
+	}
+
+
+	void runMove(const long positions[])
+	{
+		const unsigned long startTime = Timebase::getTicks();
+		movePlanner.start(positions, 0);
+
+		while(movePlanner.isMoving() && Timebase::getTicks() - startTime < MAX_TICKS)
+		{
+			motorTable.run();
+			recordSteps();
+			movePlanner.update();
+			Simulation::advance(LOOP_LATENCY);
+		}
+
+		CHECK(!movePlanner.isMoving());
+	}
+
+
+	void testMoveToPose(const long distances[])
+	{
+		startLinks();
+
+		// the barriers read as reached, so the tendons move backward only
+		long positions[NUMBER_OF_STEPPERS] = {};
+
+		for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+		{
+			positions[i] = -distances[i];
+		}
+
+		const MotionParameters parameters = DEFAULT_MOTION_PARAMETERS;
+		const unsigned long startTime = Timebase::getTicks();
+		runMove(positions);
+		const float plannedDuration = movePlanner.getPlannedDuration() / 1000.0;
+		long stepPositions[STEPPERS_PER_LINK];
+		links[0].getStepperPositions(stepPositions);
+
+		for(uint8_t i = 0; i < STEPPERS_PER_LINK; i++)
+		{
+			CHECK_EQUAL(-distances[i], stepPositions[i]);
+			CHECK_EQUAL(distances[i], numberOfSteps[i]);
+
+			if(distances[i] < 2)
+			{
+				continue;
+			}
+
+			// all tendons arrive together after about the planned duration. A few steps are faster, their first
+			// step does not wait and MIN_MOVE_SPEED keeps them from being slowed down enough
+			const float duration = static_cast<float>(stepTimes[i][numberOfSteps[i] - 1] - startTime) /
+			                       Timebase::TICKS_PER_SECOND;
+			CHECK(duration <= 1.1 * plannedDuration + 0.01);
+			CHECK(distances[i] < 10 || duration >= 0.85 * plannedDuration);
+
+			// no step is faster than a ramp from standstill or to standstill allows, v = sqrt(2an)
+			for(uint16_t j = 1; j < numberOfSteps[i]; j++)
+			{
+				const float speed = static_cast<float>(Timebase::TICKS_PER_SECOND) /
+				                    (stepTimes[i][j] - stepTimes[i][j - 1]);
+				const long remainingSteps = numberOfSteps[i] - j;
+				const float limit = sqrt(2 * parameters.acceleration * min(static_cast<long>(j), remainingSteps));
+				CHECK(speed <= 1.1 * limit + 50);
+			}
+		}
+	}
+
+
+	void testEnvelopeInFrontOfEnd()
+	{
+		startLinks();
+
+		// the pose lies just in front of the negative end position, the tendon brakes along the deceleration
+		// envelope, which is weaker than the ramp
+		const MotionParameters parameters = DEFAULT_MOTION_PARAMETERS;
+		const long negMaxPosition = -static_cast<float>(parameters.maxPosition) / parameters.posNegSpeedFactor;
+		long positions[NUMBER_OF_STEPPERS] = {};
+		positions[0] = negMaxPosition + 10;
+		runMove(positions);
+		CHECK_EQUAL(-positions[0], numberOfSteps[0]);
+
+		// the interval before step j is commanded at the position -j
+		for(uint16_t j = 1; j < numberOfSteps[0]; j++)
+		{
+			const float speed = static_cast<float>(Timebase::TICKS_PER_SECOND) /
+			                    (stepTimes[0][j] - stepTimes[0][j - 1]);
+			const long distance = -static_cast<long>(j) - negMaxPosition;
+			const float limit = sqrt(parameters.speedSlow * parameters.speedSlow +
+			                         2 * parameters.deceleration * distance);
+			CHECK(speed <= 1.02 * limit + 5);
+		}
+	}
+}
+
+
+int main()
+{
+	const long longMove[STEPPERS_PER_LINK] = { 600, 300, 100, 0 };
+	const long shortMove[STEPPERS_PER_LINK] = { 40, 20, 5, 1 };
+	testMoveToPose(longMove);
+	testMoveToPose(shortMove);
+	testEnvelopeInFrontOfEnd();
+	return Check::finish("MovePlannerTest");
+}
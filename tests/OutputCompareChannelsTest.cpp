@@ -0,0 +1,267 @@
+#include "Arduino.h"
+#include "Check.h"
+#include "MotorTable.h"
+#include "OutputCompareChannels.h"
+#include "Simulation.h"
+#include "Timebase.h"
+
+// Runs the output compare channels on the simulated timers. Pin 45 is OC5B (hardware channel 10) and pin 44 is OC5C
+// (hardware channel 11), the loop is a fixed latency between two passes.
+
+namespace
+{
+	const uint8_t PIN_45_CHANNEL = 10;
+	const uint8_t PIN_44_CHANNEL = 11;
+	const uint16_t INTERVAL = 2667; // ticks, 750 steps/s
+	const uint16_t PERIOD = 2 * (INTERVAL / 2); // the channels run on half intervals
+	const unsigned long LOOP_LATENCY = 600; // ticks between two passes of the loop
+
+	unsigned long risingEdges[2];
+	unsigned long lastRisingEdge[2];
+	unsigned long minimumSpacing[2];
+	unsigned long maximumSpacing[2];
+	unsigned long highSince[2];
+	unsigned long shortestPulse[2];
+
+	// static like in the sketch, the motors that are not begun stay at rest
+	MotorTable motorTable;
+
+
+	void recordEdge(const uint8_t hardwareChannel, const uint8_t level, const unsigned long ticks)
+	{
+		const uint8_t i = hardwareChannel - PIN_45_CHANNEL;
+
+		if(level == LOW)
+		{
+			shortestPulse[i] = min(shortestPulse[i], ticks - highSince[i]);
+			return;
+		}
+
+		if(risingEdges[i] > 0)
+		{
+			minimumSpacing[i] = min(minimumSpacing[i], ticks - lastRisingEdge[i]);
+			maximumSpacing[i] = max(maximumSpacing[i], ticks - lastRisingEdge[i]);
+		}
+
+		risingEdges[i]++;
+		lastRisingEdge[i] = ticks;
+		highSince[i] = ticks;
+	}
+
+
+	void resetSimulation()
+	{
+		Simulation::reset();
+		Simulation::setEdgeListener(recordEdge);
+		Timebase::begin();
+
+		for(uint8_t i = 0; i < 2; i++)
+		{
+			risingEdges[i] = 0;
+			lastRisingEdge[i] = 0;
+			minimumSpacing[i] = 0xFFFFFFFF;
+			maximumSpacing[i] = 0;
+			shortestPulse[i] = 0xFFFFFFFF;
+		}
+	}
+
+
+	void testAllocation()
+	{
+		resetSimulation();
+		OutputCompareChannels channels;
+
+		// only output compare pins get a channel, each pin once and at most MAX_HARDWARE_STEP_CHANNELS of them
+		CHECK_EQUAL(OutputCompareChannels::NO_CHANNEL, channels.allocate(22));
+		CHECK_EQUAL(0, channels.allocate(45));
+		CHECK_EQUAL(OutputCompareChannels::NO_CHANNEL, channels.allocate(45));
+		CHECK_EQUAL(1, channels.allocate(44));
+		CHECK_EQUAL(OutputCompareChannels::NO_CHANNEL, channels.allocate(46));
+
+		// the channels drive OC5B and OC5C and nothing else
+		channels.move(0, 1, INTERVAL);
+		CHECK(TIMSK5 & _BV(OCIE1B));
+		CHECK(!(TIMSK5 & _BV(OCIE1C)));
+		Simulation::advance(INTERVAL);
+		CHECK_EQUAL(1, risingEdges[0]);
+		CHECK_EQUAL(0, risingEdges[1]);
+		CHECK_EQUAL(1, channels.getPosition(0));
+
+		channels.move(1, -1, INTERVAL);
+		CHECK(TIMSK5 & _BV(OCIE1C));
+		Simulation::advance(INTERVAL);
+		CHECK_EQUAL(1, risingEdges[1]);
+		CHECK_EQUAL(-1, channels.getPosition(1));
+
+		// stopped channels leave their pins low and their interrupts off
+		CHECK_EQUAL(LOW, Simulation::getOutputCompareLevel(PIN_45_CHANNEL));
+		CHECK_EQUAL(LOW, Simulation::getOutputCompareLevel(PIN_44_CHANNEL));
+		CHECK(!(TIMSK5 & (_BV(OCIE1B) | _BV(OCIE1C))));
+	}
+
+
+	void testPulses()
+	{
+		resetSimulation();
+		OutputCompareChannels channels;
+		channels.allocate(45);
+
+		channels.move(0, 100, INTERVAL);
+		Simulation::advance(101UL * INTERVAL);
+
+		// a running channel steps exactly at the interval with pulses of half an interval
+		CHECK_EQUAL(100, risingEdges[0]);
+		CHECK_EQUAL(100, channels.getPosition(0));
+		CHECK_EQUAL(PERIOD, minimumSpacing[0]);
+		CHECK_EQUAL(PERIOD, maximumSpacing[0]);
+		CHECK_EQUAL(INTERVAL / 2, shortestPulse[0]);
+		CHECK_EQUAL(lastRisingEdge[0], channels.getLastStepTime(0));
+		CHECK(!channels.isRunning(0));
+	}
+
+
+	void testStepByStepCommands()
+	{
+		resetSimulation();
+		OutputCompareChannels channels;
+		channels.allocate(45);
+
+		// the loop commands one step whenever the channel stopped. The step follows the previous one after the
+		// interval, the latency of the loop does not add to it
+		for(unsigned long i = 0; i < 2000; i++)
+		{
+			if(!channels.isRunning(0))
+			{
+				channels.move(0, 1, INTERVAL);
+			}
+
+			Simulation::advance(LOOP_LATENCY);
+		}
+
+		CHECK(risingEdges[0] > 400);
+		CHECK_EQUAL(PERIOD, minimumSpacing[0]);
+		CHECK_EQUAL(PERIOD, maximumSpacing[0]);
+	}
+
+
+	void testQueuedCommands()
+	{
+		resetSimulation();
+		OutputCompareChannels channels;
+		channels.allocate(45);
+		boolean hasStopped = false;
+
+		// the loop queues the next step as soon as the channel took the previous one, the channel goes on at the
+		// end of the pulse and never stops in between
+		for(unsigned long i = 0; i < 2000; i++)
+		{
+			if(channels.getTargetPosition(0) == channels.getPosition(0))
+			{
+				channels.move(0, 1, INTERVAL);
+			}
+
+			Simulation::advance(LOOP_LATENCY);
+			hasStopped |= !channels.isRunning(0);
+		}
+
+		CHECK(!hasStopped);
+		CHECK(risingEdges[0] > 400);
+		CHECK_EQUAL(PERIOD, minimumSpacing[0]);
+		CHECK_EQUAL(PERIOD, maximumSpacing[0]);
+	}
+
+
+	void testSameRateAsSoftware()
+	{
+		resetSimulation();
+		OutputCompareChannels channels;
+		motorTable.useOutputCompareChannels(channels);
+		motorTable.begin(0, 45, 47);
+		motorTable.begin(1, 22, 23);
+		const unsigned long end = 2000000; // one second
+		unsigned long lastSoftwareStepTime = 0;
+		unsigned long misplacedStepTimes = 0;
+
+		// the antagonists of a tendon pair, one on a hardware channel and one in software, get the same commands
+		while(Simulation::getTicks() < end)
+		{
+			motorTable.run();
+
+			// the step time of the software motor is its rising edge, which is now. The time the step was due is
+			// earlier by the loop latency
+			if(motorTable.getLastStepTime(1) != lastSoftwareStepTime)
+			{
+				lastSoftwareStepTime = motorTable.getLastStepTime(1);
+				misplacedStepTimes += lastSoftwareStepTime != Timebase::getTicks();
+			}
+
+			for(uint8_t motor = 0; motor < 2; motor++)
+			{
+				if(!motorTable.isRunning(motor))
+				{
+					motorTable.move(motor, motor == 0 ? 1 : -1, INTERVAL);
+				}
+			}
+
+			Simulation::advance(LOOP_LATENCY);
+		}
+
+		const long hardwareSteps = motorTable.getPosition(0);
+		const long softwareSteps = -motorTable.getPosition(1);
+		CHECK(hardwareSteps >= 745 && hardwareSteps <= 751);
+		CHECK(softwareSteps >= hardwareSteps - 1 && softwareSteps <= hardwareSteps + 1);
+		CHECK(lastSoftwareStepTime > 0);
+		CHECK_EQUAL(0, misplacedStepTimes);
+	}
+
+
+	void testRebaseWhileRunning()
+	{
+		resetSimulation();
+		OutputCompareChannels channels;
+		channels.allocate(45);
+
+		// the homing overrides the position on every pass and commands the next step when the previous one is done,
+		// the re-basing must not cancel the running step
+		for(unsigned long i = 0; i < 2000; i++)
+		{
+			channels.setPosition(0, -1);
+
+			if(!channels.isRunning(0))
+			{
+				channels.move(0, 1, INTERVAL);
+			}
+
+			Simulation::advance(LOOP_LATENCY);
+		}
+
+		CHECK(risingEdges[0] > 400);
+		CHECK_EQUAL(PERIOD, minimumSpacing[0]);
+		CHECK_EQUAL(INTERVAL / 2, shortestPulse[0]);
+
+		// a re-based target keeps its remaining steps
+		resetSimulation();
+		OutputCompareChannels otherChannels;
+		otherChannels.allocate(45);
+		otherChannels.move(0, 10, INTERVAL);
+		Simulation::advance(3UL * INTERVAL);
+		const long position = otherChannels.getPosition(0);
+		otherChannels.setPosition(0, 1000);
+		CHECK_EQUAL(1000 + 10 - position, otherChannels.getTargetPosition(0));
+		Simulation::advance(11UL * INTERVAL);
+		CHECK_EQUAL(10, risingEdges[0]);
+		CHECK_EQUAL(1000 + 10 - position, otherChannels.getPosition(0));
+	}
+}
+
+
+int main()
+{
+	testAllocation();
+	testPulses();
+	testStepByStepCommands();
+	testQueuedCommands();
+	testSameRateAsSoftware();
+	testRebaseWhileRunning();
+	return Check::finish("OutputCompareChannelsTest");
+}
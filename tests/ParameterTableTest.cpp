@@ -0,0 +1,249 @@
+#include "Arduino.h"
+#include "Check.h"
+#include "EEPROM.h"
+#include "ParameterTable.h"
+#include "Simulation.h"
+
+// Changes the parameters the way the serial commands do and loads them from a prepared EEPROM. Values out of their
+// range or out of the speed order never reach the links.
+
+namespace
+{
+	const uint8_t SLOW = 0;
+	const uint8_t FAST = 1;
+	const uint8_t FACTOR = 2;
+	const uint8_t MAX_POSITION = 3;
+	const uint8_t MAX_SPEED = 4;
+	const uint8_t JERK = 7;
+	const uint16_t CHECKSUM_ADDRESS = EEPROM_PARAMETERS_ADDRESS + 3;
+	const uint16_t PARAMETERS_ADDRESS = EEPROM_PARAMETERS_ADDRESS + 4;
+
+
+	// the rotate and xor of ParameterTable over the stored parameters of all links
+	void updateStoredChecksum()
+	{
+		uint8_t checksum = 0;
+
+		for(uint16_t i = 0; i < NUMBER_OF_LINKS * sizeof(MotionParameters); i++)
+		{
+			checksum = (checksum << 1 | checksum >> 7) ^ EEPROM.read(PARAMETERS_ADDRESS + i);
+		}
+
+		EEPROM.write(CHECKSUM_ADDRESS, checksum);
+	}
+
+
+	void storeLinkParameters(const uint8_t link, const MotionParameters &parameters)
+	{
+		EEPROM.put(PARAMETERS_ADDRESS + link * sizeof(MotionParameters), parameters);
+		updateStoredChecksum();
+	}
+
+
+	void testRanges()
+	{
+		Simulation::reset();
+		ParameterTable table;
+		table.begin();
+
+		// every parameter accepts its limits and rejects values outside, a rejected value changes nothing
+		for(uint8_t i = 0; i < ParameterTable::NUMBER_OF_PARAMETERS; i++)
+		{
+			const float value = table.getValue(0, i);
+			CHECK(!table.setValue(0, i, table.getMinValue(i) - 1));
+			CHECK(!table.setValue(0, i, table.getMaxValue(i) * 2));
+			CHECK(!table.setValue(0, i, NAN));
+			CHECK_EQUAL(value, table.getValue(0, i));
+		}
+
+		CHECK(table.setValue(0, MAX_POSITION, 32767));
+		CHECK(!table.setValue(0, MAX_POSITION, 32768));
+		CHECK(!table.setValue(0, FACTOR, 0.5));
+		CHECK(!table.setValue(0, MAX_SPEED, 1e9));
+		CHECK(!table.setValue(0, JERK, 1e9));
+		CHECK(!table.setValue(NUMBER_OF_LINKS, FAST, 300));
+		CHECK(!table.setValue(0, ParameterTable::NUMBER_OF_PARAMETERS, 300));
+
+		// a jerk of 0 selects the trapezoidal ramp
+		CHECK(table.setValue(0, JERK, table.getMaxValue(JERK)));
+		CHECK(table.setValue(0, JERK, 0));
+		CHECK(!table.setValue(0, JERK, 1));
+	}
+
+
+	void testSpeedOrder()
+	{
+		Simulation::reset();
+		ParameterTable table;
+		table.begin();
+
+		// slow <= fast <= maxspeed, equal speeds are allowed
+		CHECK(!table.setValue(0, SLOW, table.getValue(0, FAST) + 1));
+		CHECK(!table.setValue(0, FAST, table.getValue(0, MAX_SPEED) + 1));
+		CHECK(!table.setValue(0, FAST, table.getValue(0, SLOW) - 1));
+		CHECK(!table.setValue(0, MAX_SPEED, table.getValue(0, FAST) - 1));
+		CHECK(table.setValue(0, SLOW, table.getValue(0, FAST)));
+		CHECK(table.setValue(0, MAX_SPEED, table.getValue(0, FAST)));
+	}
+
+
+	void testAllLinks()
+	{
+		if(NUMBER_OF_LINKS < 2)
+		{
+			return;
+		}
+
+		Simulation::reset();
+		ParameterTable table;
+		table.begin();
+		CHECK(table.setValue(1, MAX_SPEED, 1500));
+		CHECK(table.setValue(1, FAST, 1200));
+		table.clearPendingChanges();
+
+		// a value that only one link can take is rejected for all of them
+		CHECK(!table.setValue(ParameterTable::ALL_LINKS, FAST, 1000));
+		CHECK_EQUAL(DEFAULT_MOTION_PARAMETERS.speedFast, table.getValue(0, FAST));
+		CHECK_EQUAL(1200, table.getValue(1, FAST));
+		CHECK(!table.hasPendingChanges());
+
+		CHECK(table.setValue(ParameterTable::ALL_LINKS, FAST, 700));
+
+		for(uint8_t i = 0; i < NUMBER_OF_LINKS; i++)
+		{
+			CHECK_EQUAL(700, table.getValue(i, FAST));
+		}
+
+		CHECK(table.hasPendingChanges());
+	}
+
+
+	void testLoad()
+	{
+		Simulation::reset();
+		ParameterTable table;
+		table.begin();
+		CHECK(table.setValue(ParameterTable::ALL_LINKS, MAX_POSITION, 2000));
+		table.save();
+
+		while(table.continueSave())
+		{
+		}
+
+		ParameterTable loadedTable;
+		CHECK(loadedTable.load());
+		CHECK_EQUAL(2000, loadedTable.getValue(NUMBER_OF_LINKS - 1, MAX_POSITION));
+
+		// stored values out of range or out of order are rejected even with a correct checksum, the defaults are
+		// used instead
+		MotionParameters parameters = DEFAULT_MOTION_PARAMETERS;
+		parameters.maxPosition = 40000;
+		storeLinkParameters(NUMBER_OF_LINKS - 1, parameters);
+		CHECK(!loadedTable.load());
+		CHECK_EQUAL(2000, loadedTable.getValue(0, MAX_POSITION));
+
+		ParameterTable defaultTable;
+		defaultTable.begin();
+		CHECK_EQUAL(DEFAULT_MOTION_PARAMETERS.maxPosition, defaultTable.getValue(0, MAX_POSITION));
+
+		parameters = DEFAULT_MOTION_PARAMETERS;
+		parameters.speedSlow = parameters.speedFast + 1;
+		storeLinkParameters(NUMBER_OF_LINKS - 1, parameters);
+		CHECK(!loadedTable.load());
+
+		parameters = DEFAULT_MOTION_PARAMETERS;
+		parameters.posNegSpeedFactor = NAN;
+		storeLinkParameters(NUMBER_OF_LINKS - 1, parameters);
+		CHECK(!loadedTable.load());
+
+		storeLinkParameters(NUMBER_OF_LINKS - 1, DEFAULT_MOTION_PARAMETERS);
+		CHECK(loadedTable.load());
+	}
+
+
+	// counts the bytes that differ between the EEPROM and a copy
+	uint16_t countChangedBytes(const uint8_t copy[])
+	{
+		uint16_t changedBytes = 0;
+
+		for(uint16_t i = 0; i < EEPROM.length(); i++)
+		{
+			changedBytes += EEPROM.read(i) != copy[i];
+		}
+
+		return changedBytes;
+	}
+
+
+	void testIncrementalSave()
+	{
+		Simulation::reset();
+		ParameterTable table;
+		table.begin();
+		table.restoreDefaults();
+		table.save();
+
+		while(table.continueSave())
+		{
+		}
+
+		// every pass writes one byte at most, the stored parameters cannot be loaded until the save is complete
+		CHECK(table.setValue(ParameterTable::ALL_LINKS, MAX_POSITION, 3000));
+		table.save();
+		CHECK(table.isSaving());
+		static uint8_t copy[sizeof(EEPROM.memory)];
+		uint16_t passes = 0;
+
+		do
+		{
+			memcpy(copy, EEPROM.memory, sizeof(copy));
+			CHECK(countChangedBytes(copy) == 0);
+			passes++;
+
+			ParameterTable loadedTable;
+			CHECK(passes == 1 ? loadedTable.load() : !loadedTable.load());
+
+			if(!table.continueSave())
+			{
+				break;
+			}
+
+			CHECK(countChangedBytes(copy) <= 1);
+		}
+		while(passes < 1000);
+
+		CHECK(!table.isSaving());
+		CHECK_EQUAL(NUMBER_OF_LINKS * sizeof(MotionParameters) + 5, passes);
+		ParameterTable loadedTable;
+		CHECK(loadedTable.load());
+		CHECK_EQUAL(3000, loadedTable.getValue(NUMBER_OF_LINKS - 1, MAX_POSITION));
+
+		// a change during the save starts it over, the last value is stored
+		table.save();
+
+		for(uint8_t i = 0; i < 50; i++)
+		{
+			table.continueSave();
+		}
+
+		CHECK(table.setValue(ParameterTable::ALL_LINKS, MAX_POSITION, 1000));
+
+		while(table.continueSave())
+		{
+		}
+
+		CHECK(loadedTable.load());
+		CHECK_EQUAL(1000, loadedTable.getValue(0, MAX_POSITION));
+	}
+}
+
+
+int main()
+{
+	testRanges();
+	testSpeedOrder();
+	testAllLinks();
+	testLoad();
+	testIncrementalSave();
+	return Check::finish("ParameterTableTest");
+}
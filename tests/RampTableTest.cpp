@@ -0,0 +1,269 @@
+#include <math.h>
+#include "Arduino.h"
+#include "Check.h"
+#include "Configuration.h"
+#include "MotorTable.h"
+#include "RampTable.h"
+#include "Simulation.h"
+#include "Stepper.h"
+#include "Timebase.h"
+
+// Drives the ramps step by step and compares the speed of every step with the ideal acceleration.
+
+namespace
+{
+	const uint16_t FAST_INTERVAL = 2; // ticks, faster than any ramp allows
+	const unsigned long LOOP_LATENCY = 100; // ticks between two passes of the loop
+	const uint16_t MAX_RAMP_STEPS = 4000;
+
+	MotorTable motorTable; // static like in the sketch
+	Stepper stepper;
+
+
+	// the speed in steps per second of every step until the max speed is reached, returns the number of steps
+	uint16_t runRamp(const RampTable &rampTable, const float maxSpeed, float speeds[])
+	{
+		uint16_t step = 0;
+		uint16_t length = 0;
+
+		while(length < MAX_RAMP_STEPS)
+		{
+			const uint16_t interval = rampTable.limitInterval(FAST_INTERVAL, step);
+			speeds[length] = static_cast<float>(Timebase::TICKS_PER_SECOND) / interval;
+			length++;
+			step++;
+
+			if(speeds[length - 1] >= maxSpeed * 0.999)
+			{
+				break;
+			}
+		}
+
+		return length;
+	}
+
+
+	MotionParameters getParameters(const float acceleration, const float jerk,
+	                               const float maxSpeed = DEFAULT_MOTION_PARAMETERS.maxSpeed)
+	{
+		MotionParameters parameters = DEFAULT_MOTION_PARAMETERS;
+		parameters.acceleration = acceleration;
+		parameters.jerk = jerk;
+		parameters.maxSpeed = maxSpeed;
+		return parameters;
+	}
+
+
+	void testTrapezoid(const float acceleration)
+	{
+		RampTable rampTable;
+		const MotionParameters parameters = getParameters(acceleration, 0);
+		rampTable.build(parameters);
+		static float speeds[MAX_RAMP_STEPS];
+		const uint16_t length = runRamp(rampTable, parameters.maxSpeed, speeds);
+
+		// the ramp ends where the max speed is reached
+		const float rampSteps = parameters.maxSpeed * parameters.maxSpeed / (2 * acceleration);
+		CHECK(length >= rampSteps * 0.9 - 2 && length <= rampSteps * 1.1 + 2);
+
+		// the interval before every step is close to the ideal speed sqrt(2an) half a step earlier, no step jumps
+		// ahead
+		for(uint16_t i = 2; i < length - 1; i++)
+		{
+			const float idealSpeed = sqrt(2 * acceleration * (i - 0.5));
+			CHECK(speeds[i] <= 1.1 * idealSpeed && speeds[i] >= 0.75 * idealSpeed);
+			CHECK(speeds[i] >= speeds[i - 1]);
+			CHECK(speeds[i] / speeds[i - 1] <= 1.1 * idealSpeed / sqrt(2 * acceleration * (i - 1.5)));
+		}
+	}
+
+
+	// the times the steps of an ideal S-curve are reached, integrated in microseconds. Returns the number of steps
+	uint16_t getSCurveStepTimes(const MotionParameters &parameters, double times[])
+	{
+		const double timeStep = 1e-6;
+		double acceleration = 0;
+		double velocity = 0;
+		double position = 0;
+		double time = 0;
+		uint16_t length = 1;
+		times[0] = 0;
+
+		while(velocity < parameters.maxSpeed && length < MAX_RAMP_STEPS)
+		{
+			const double remainingGain = acceleration * acceleration / (2 * parameters.jerk);
+
+			if(velocity + remainingGain >= parameters.maxSpeed)
+			{
+				acceleration = max(acceleration - parameters.jerk * timeStep, 0.0);
+			}
+			else
+			{
+				acceleration = min(acceleration + parameters.jerk * timeStep, (double) parameters.acceleration);
+			}
+
+			velocity += acceleration * timeStep;
+			position += velocity * timeStep;
+			time += timeStep;
+
+			if(position >= length)
+			{
+				times[length] = time;
+				length++;
+			}
+		}
+
+		return length;
+	}
+
+
+	void testSCurve(const float acceleration, const float jerk)
+	{
+		RampTable rampTable;
+		const MotionParameters parameters = getParameters(acceleration, jerk);
+		rampTable.build(parameters);
+		static float speeds[MAX_RAMP_STEPS];
+		static double times[MAX_RAMP_STEPS];
+		const uint16_t length = runRamp(rampTable, parameters.maxSpeed, speeds);
+		const uint16_t idealLength = getSCurveStepTimes(parameters, times);
+		CHECK(length >= idealLength * 0.9 - 2 && length <= idealLength * 1.1 + 2);
+
+		// the interval before every step is close to the ideal one, the intervals that do not fit into 16 bit are
+		// left out. No step is faster than the ideal one by more than the rounding; on long ramps the steps between
+		// two entries are slower
+		for(uint16_t i = 2; i < min(length, idealLength) - 1; i++)
+		{
+			const double idealSpeed = 1 / (times[i] - times[i - 1]);
+
+			if(idealSpeed < Timebase::TICKS_PER_SECOND / 65535.0)
+			{
+				continue;
+			}
+
+			CHECK(speeds[i] <= 1.05 * idealSpeed + 1 && speeds[i] >= 0.65 * idealSpeed);
+			CHECK(speeds[i] >= speeds[i - 1]);
+		}
+	}
+
+
+	// the limits of the acceleration and the jerk at the highest max speed. The ramp reaches the max speed after
+	// about the ideal number of steps and no step is faster than the ideal one. Between the first entries that cover
+	// several steps the steps are much slower, the whole ramp still takes little longer than the ideal one
+	void testExtremes(const float acceleration, const float jerk)
+	{
+		RampTable rampTable;
+		const MotionParameters parameters = getParameters(acceleration, jerk, 2000);
+		rampTable.build(parameters);
+		static float speeds[MAX_RAMP_STEPS];
+		static double times[MAX_RAMP_STEPS];
+		const uint16_t length = runRamp(rampTable, parameters.maxSpeed, speeds);
+		CHECK(length < MAX_RAMP_STEPS);
+		CHECK(speeds[length - 1] >= parameters.maxSpeed * 0.999);
+
+		if(jerk == 0)
+		{
+			// t(n) = sqrt(2n / a)
+			for(uint16_t i = 0; i < MAX_RAMP_STEPS; i++)
+			{
+				times[i] = sqrt(2.0 * i / acceleration);
+			}
+		}
+
+		const uint16_t idealLength = jerk > 0 ? getSCurveStepTimes(parameters, times) :
+		                             parameters.maxSpeed * parameters.maxSpeed / (2 * acceleration);
+		CHECK(length >= idealLength * 0.9 - 2 && length <= idealLength * 1.1 + 2);
+		const uint16_t end = min(length, idealLength) - 1;
+		double duration = 0;
+
+		for(uint16_t i = 2; i < end; i++)
+		{
+			const double idealSpeed = 1 / (times[i] - times[i - 1]);
+			duration += 1 / speeds[i];
+			CHECK(speeds[i] <= 1.05 * idealSpeed + 1 || idealSpeed < Timebase::TICKS_PER_SECOND / 65535.0);
+			CHECK(speeds[i] >= speeds[i - 1]);
+		}
+
+		CHECK(duration <= 1.35 * (times[end - 1] - times[1]));
+	}
+
+
+	void testSlowerCommand()
+	{
+		RampTable rampTable;
+		const MotionParameters parameters = getParameters(3000, 0);
+		rampTable.build(parameters);
+		static float speeds[MAX_RAMP_STEPS];
+		const uint16_t length = runRamp(rampTable, parameters.maxSpeed, speeds);
+
+		// a slower command moves the step back, past the end the step is held there
+		uint16_t step = length / 2;
+		rampTable.limitInterval(60000, step);
+		CHECK(step < length / 2);
+
+		step = 60000;
+		rampTable.limitInterval(FAST_INTERVAL, step);
+		CHECK(step <= length);
+	}
+
+
+	void testRampWithRebasing()
+	{
+		Simulation::reset();
+		Timebase::begin();
+		RampTable rampTable;
+		const MotionParameters parameters = getParameters(3000, 0);
+		rampTable.build(parameters);
+		const TendonConfig config = { 22, 23, 0 };
+		stepper.begin(motorTable, 0, config, rampTable);
+		unsigned long stepTimes[20];
+		uint8_t steps = 0;
+		unsigned long lastStepTime = 0;
+
+		// the homing overrides the position on every pass, the ramp still counts the steps taken
+		while(steps < 20)
+		{
+			motorTable.run();
+
+			if(motorTable.getLastStepTime(0) != lastStepTime)
+			{
+				lastStepTime = motorTable.getLastStepTime(0);
+				stepTimes[steps] = lastStepTime;
+				steps++;
+			}
+
+			stepper.setCurrentPosition(-1);
+			stepper.moveForward(FAST_INTERVAL);
+			Simulation::advance(LOOP_LATENCY);
+		}
+
+		// the steps follow t = sqrt(2n / a) from the first one, the second step comes earlier by the correction of c0
+		for(uint8_t i = 1; i < 20; i++)
+		{
+			const float idealTime = sqrt(2.0 * i / parameters.acceleration) -
+			                        (1 - 0.676) * sqrt(2.0 / parameters.acceleration);
+			const float time = static_cast<float>(stepTimes[i] - stepTimes[0]) / Timebase::TICKS_PER_SECOND;
+			CHECK(fabs(time - idealTime) <= 0.1 * idealTime);
+		}
+	}
+}
+
+
+int main()
+{
+	testTrapezoid(3000);
+	testTrapezoid(500);
+	testTrapezoid(40000);
+	testSCurve(3000, 20000);
+	testSCurve(3000, 2000);
+	testSCurve(500, 100000);
+	testSCurve(40000, 1000000);
+	testExtremes(1000, 0);
+	testExtremes(40000, 0);
+	testExtremes(1000, 1000);
+	testExtremes(1000, 1000000);
+	testExtremes(40000, 1000);
+	testExtremes(40000, 1000000);
+	testSlowerCommand();
+	testRampWithRebasing();
+	return Check::finish("RampTableTest");
+}
@@ -0,0 +1,178 @@
+#include "Arduino.h"
+#include "Check.h"
+#include "Scheduler.h"
+
+// Runs the scheduler on a virtual clock. Every task advances the clock by its simulated run time, so lateness and
+// overruns are exactly predictable.
+
+namespace
+{
+	unsigned long now = 0;
+	unsigned long slowTaskDuration = 0;
+	int fastRuns = 0;
+	int firstRuns = 0;
+	int secondRuns = 0;
+	int slowRuns = 0;
+
+
+	void fastTask()
+	{
+		fastRuns++;
+		now += 10;
+	}
+
+
+	void firstTask()
+	{
+		firstRuns++;
+		now += 50;
+	}
+
+
+	void secondTask()
+	{
+		secondRuns++;
+		now += 50;
+	}
+
+
+	void slowTask()
+	{
+		slowRuns++;
+		now += slowTaskDuration;
+	}
+
+
+	void resetCounters()
+	{
+		fastRuns = 0;
+		firstRuns = 0;
+		secondRuns = 0;
+		slowRuns = 0;
+	}
+
+
+	void runFor(Scheduler &scheduler, const unsigned long duration)
+	{
+		const unsigned long end = now + duration;
+
+		while(static_cast<long>(end - now) > 0)
+		{
+			scheduler.run(now);
+			now += 5; // the loop overhead
+		}
+	}
+
+
+	void testRates()
+	{
+		Scheduler scheduler;
+		now = 0;
+		resetCounters();
+		CHECK(scheduler.addTask(fastTask, 0));
+		CHECK(scheduler.addTask(firstTask, 5000));
+		CHECK(scheduler.addTask(secondTask, 20000));
+
+		runFor(scheduler, 1000000);
+
+		// the periodic tasks keep their rate, the fast task fills the remaining time
+		CHECK(firstRuns >= 199 && firstRuns <= 201);
+		CHECK(secondRuns >= 49 && secondRuns <= 51);
+		CHECK(fastRuns > 50000);
+		CHECK_EQUAL(0, scheduler.getOverruns(1));
+		CHECK_EQUAL(0, scheduler.getOverruns(2));
+		CHECK(scheduler.getMaxLateness(1) < 200);
+	}
+
+
+	void testOnePeriodicTaskPerRun()
+	{
+		Scheduler scheduler;
+		now = 0;
+		resetCounters();
+		scheduler.addTask(firstTask, 1000);
+		scheduler.addTask(secondTask, 1000);
+
+		// both tasks are due at the start, only the first one runs
+		scheduler.run(now);
+		CHECK_EQUAL(1, firstRuns);
+		CHECK_EQUAL(0, secondRuns);
+
+		scheduler.run(now);
+		CHECK_EQUAL(1, firstRuns);
+		CHECK_EQUAL(1, secondRuns);
+	}
+
+
+	void testOverruns()
+	{
+		Scheduler scheduler;
+		now = 0;
+		resetCounters();
+		scheduler.addTask(fastTask, 0);
+		scheduler.addTask(firstTask, 5000);
+		scheduler.addTask(slowTask, 100000);
+
+		// a slow task that blocks for 12 ms makes the 5 ms task miss two whole periods each time
+		slowTaskDuration = 12000;
+		runFor(scheduler, 1000000);
+
+		CHECK(slowRuns >= 9 && slowRuns <= 11);
+		CHECK(scheduler.getOverruns(1) >= slowRuns);
+		CHECK(scheduler.getMaxLateness(1) >= 7000);
+		CHECK_EQUAL(0, scheduler.getOverruns(2));
+
+		// the missed periods are not caught up in a burst: fewer runs than periods
+		CHECK(firstRuns < 200);
+
+		scheduler.resetStatistics();
+		CHECK_EQUAL(0, scheduler.getOverruns(1));
+		CHECK_EQUAL(0, scheduler.getMaxLateness(1));
+
+		slowTaskDuration = 1000;
+		runFor(scheduler, 1000000);
+		CHECK_EQUAL(0, scheduler.getOverruns(1));
+		CHECK(scheduler.getMaxLateness(1) < 1200);
+	}
+
+
+	void testClockOverflow()
+	{
+		Scheduler scheduler;
+		now = 0xFFFFFFFFUL - 100000;
+		resetCounters();
+		scheduler.addTask(firstTask, 5000);
+
+		runFor(scheduler, 200000);
+
+		// the micros() overflow in the middle changes nothing
+		CHECK(firstRuns >= 39 && firstRuns <= 41);
+		CHECK_EQUAL(0, scheduler.getOverruns(0));
+	}
+
+
+	void testTaskLimit()
+	{
+		Scheduler scheduler;
+		uint8_t added = 0;
+
+		while(scheduler.addTask(fastTask, 0) && added < 100)
+		{
+			added++;
+		}
+
+		CHECK_EQUAL(added, scheduler.getNumberOfTasks());
+		CHECK(added >= 11); // the firmware adds 11 tasks
+	}
+}
+
+
+int main()
+{
+	testRates();
+	testOnePeriodicTaskPerRun();
+	testOverruns();
+	testClockOverflow();
+	testTaskLimit();
+	return Check::finish("SchedulerTest");
+}
@@ -0,0 +1,76 @@
+#include <chrono>
+#include "Arduino.h"
+#include "Check.h"
+#include "MotorTable.h"
+#include "Simulation.h"
+#include "Timebase.h"
+
+// Runs the step loop over all motors at the pulse rate of the highest max speed with 8 and 16 microsteps. In the
+// simulated time every motor has to keep its rate while the loop is faster than the interval. The host time of a
+// run is printed to compare changes of the step loop with each other, it does not tell the time on the ATmega2560.
+
+namespace
+{
+	const float MAX_SPEED = 2000; // full steps per second, the upper limit of maxspeed
+	const unsigned long LOOP_LATENCY = 20; // ticks between two passes of the loop
+	const unsigned long DURATION = 200000; // ticks, a tenth of a second
+	const long FAR_AWAY = 1000000; // steps, never reached within the duration
+
+	MotorTable motorTable; // static like in the sketch
+
+
+	void startMotors(const uint16_t interval)
+	{
+		Simulation::reset();
+		Timebase::begin();
+
+		for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+		{
+			const LinkConfig &link = LINK_CONFIGS[i / STEPPERS_PER_LINK];
+			const TendonConfig tendons[STEPPERS_PER_LINK] = { link.up, link.right, link.down, link.left };
+			const TendonConfig &tendon = tendons[i % STEPPERS_PER_LINK];
+			motorTable.begin(i, tendon.stepPin, tendon.directionPin);
+			motorTable.move(i, FAR_AWAY, interval);
+		}
+	}
+
+
+	void benchmarkMicrosteps(const uint8_t microsteps)
+	{
+		const uint16_t interval = Timebase::TICKS_PER_SECOND / (MAX_SPEED * microsteps);
+		startMotors(interval);
+		const unsigned long startTicks = Timebase::getTicks();
+		unsigned long runs = 0;
+		std::chrono::nanoseconds hostTime(0);
+
+		while(Timebase::getTicks() - startTicks < DURATION)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			motorTable.run();
+			hostTime += std::chrono::steady_clock::now() - start;
+			runs++;
+			Simulation::advance(LOOP_LATENCY);
+		}
+
+		// the step times advance by the interval, so every motor keeps the exact rate
+		const long expectedSteps = DURATION / interval;
+
+		for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+		{
+			CHECK(labs(motorTable.getPosition(i) - expectedSteps) <= 1);
+		}
+
+		const double nanosecondsPerRun = static_cast<double>(hostTime.count()) / runs;
+		printf("%u motors, %u microsteps: %u pulses/s each (interval %u ticks), host %.0f ns per run, %.0f ns per "
+		       "motor\n", NUMBER_OF_STEPPERS, microsteps, static_cast<unsigned>(MAX_SPEED * microsteps), interval,
+		       nanosecondsPerRun, nanosecondsPerRun / NUMBER_OF_STEPPERS);
+	}
+}
+
+
+int main()
+{
+	benchmarkMicrosteps(8);
+	benchmarkMicrosteps(16);
+	return Check::finish("StepRateBenchmark");
+}
@@ -0,0 +1,175 @@
+#include <chrono>
+#include "Arduino.h"
+#include "AccelStepper.h"
+#include "Check.h"
+#include "MotorTable.h"
+#include "RampTable.h"
+#include "Simulation.h"
+#include "Stepper.h"
+#include "Timebase.h"
+
+// Compares the step/dir core with the general purpose AccelStepper it replaced. The Makefile takes AccelStepper
+// from the baseline commit. Both drive the tendons of all links the way the baseline Stepper did: every pass of
+// the loop runs the steppers, a stepper that reached its target gets the next one-step command. AccelStepper takes
+// a float speed per command, the core an interval. The host time is printed to compare the two paths with each
+// other, it does not tell the cycles on the ATmega2560: the simulated timer registers cost the core more than the
+// real ones, and the pin writes and pulse delays of AccelStepper cost it less. The RAM is that of the host build.
+
+namespace
+{
+	const unsigned long LOOP_LATENCY = 20; // ticks between two passes of the loop
+	const unsigned long DURATION = 2000000; // ticks, one second
+	const uint8_t NUMBER_OF_SPEEDS = 4;
+	const float SPEEDS[NUMBER_OF_SPEEDS] = { 750, 700, 650, 700 }; // steps per second, a changing command
+
+	// static like in the sketch
+	MotorTable motorTable;
+	RampTable rampTable;
+	Stepper steppers[NUMBER_OF_STEPPERS];
+
+
+	const TendonConfig &getTendon(const uint8_t motor)
+	{
+		const LinkConfig &link = LINK_CONFIGS[motor / STEPPERS_PER_LINK];
+		const TendonConfig *tendons[STEPPERS_PER_LINK] = { &link.up, &link.right, &link.down, &link.left };
+		return *tendons[motor % STEPPERS_PER_LINK];
+	}
+
+
+	void printResult(const char *name, const std::chrono::nanoseconds hostTime, const unsigned long passes,
+	                 const long steps, const size_t bytesPerMotor)
+	{
+		printf("%-12s %5.0f ns per pass, %5.0f ns per step, %ld steps, %u bytes per motor\n", name,
+		       static_cast<double>(hostTime.count()) / passes, static_cast<double>(hostTime.count()) / steps, steps,
+		       static_cast<unsigned>(bytesPerMotor));
+	}
+
+
+	std::chrono::nanoseconds runAccelStepper(unsigned long &passes, long &steps)
+	{
+		Simulation::reset();
+		static AccelStepper accelSteppers[NUMBER_OF_STEPPERS];
+		uint8_t commands = 0;
+
+		for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+		{
+			accelSteppers[i] = AccelStepper(AccelStepper::DRIVER, getTendon(i).stepPin, getTendon(i).directionPin);
+			accelSteppers[i].setMaxSpeed(SPEEDS[0]);
+		}
+
+		std::chrono::nanoseconds hostTime(0);
+		passes = 0;
+
+		while(Simulation::getTicks() < DURATION)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+			{
+				accelSteppers[i].runSpeedToPosition();
+
+				if(accelSteppers[i].distanceToGo() == 0)
+				{
+					accelSteppers[i].move(1);
+					accelSteppers[i].setSpeed(SPEEDS[commands % NUMBER_OF_SPEEDS]);
+					commands++;
+				}
+			}
+
+			hostTime += std::chrono::steady_clock::now() - start;
+			passes++;
+			Simulation::advance(LOOP_LATENCY);
+		}
+
+		steps = 0;
+
+		for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+		{
+			steps += accelSteppers[i].currentPosition();
+		}
+
+		return hostTime;
+	}
+
+
+	std::chrono::nanoseconds runCore(unsigned long &passes, long &steps)
+	{
+		Simulation::reset();
+		Timebase::begin();
+		rampTable.build(DEFAULT_MOTION_PARAMETERS);
+		uint16_t intervals[NUMBER_OF_SPEEDS];
+		uint8_t commands = 0;
+
+		// the links get their intervals from the speed profile, not from a float division
+		for(uint8_t i = 0; i < NUMBER_OF_SPEEDS; i++)
+		{
+			intervals[i] = Timebase::TICKS_PER_SECOND / SPEEDS[i];
+		}
+
+		for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+		{
+			steppers[i].begin(motorTable, i, getTendon(i), rampTable);
+		}
+
+		std::chrono::nanoseconds hostTime(0);
+		passes = 0;
+
+		while(Simulation::getTicks() < DURATION)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			motorTable.run();
+
+			for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+			{
+				if(steppers[i].moveForward(intervals[commands % NUMBER_OF_SPEEDS]))
+				{
+					commands++;
+				}
+			}
+
+			hostTime += std::chrono::steady_clock::now() - start;
+			passes++;
+			Simulation::advance(LOOP_LATENCY);
+		}
+
+		steps = 0;
+
+		for(uint8_t i = 0; i < NUMBER_OF_STEPPERS; i++)
+		{
+			steps += steppers[i].getCurrentPosition();
+		}
+
+		return hostTime;
+	}
+
+
+	void compareStepPaths()
+	{
+		unsigned long accelStepperPasses = 0;
+		long accelStepperSteps = 0;
+		const std::chrono::nanoseconds accelStepperTime = runAccelStepper(accelStepperPasses, accelStepperSteps);
+		unsigned long corePasses = 0;
+		long coreSteps = 0;
+		const std::chrono::nanoseconds coreTime = runCore(corePasses, coreSteps);
+		const size_t tableShare = (sizeof(MotorTable) + NUMBER_OF_STEPPERS - 1) / NUMBER_OF_STEPPERS;
+
+		printResult("AccelStepper", accelStepperTime, accelStepperPasses, accelStepperSteps, sizeof(AccelStepper));
+		printResult("step core", coreTime, corePasses, coreSteps, tableShare + sizeof(Stepper));
+
+		// both keep up with the commands, the core loses the steps of its ramp at the start, v^2 / (2a)
+		const long expectedSteps = NUMBER_OF_STEPPERS * (SPEEDS[0] + SPEEDS[1] + SPEEDS[2] + SPEEDS[3]) /
+		                           NUMBER_OF_SPEEDS * DURATION / Timebase::TICKS_PER_SECOND;
+		const long rampSteps = NUMBER_OF_STEPPERS * SPEEDS[0] * SPEEDS[0] /
+		                       (2 * DEFAULT_MOTION_PARAMETERS.acceleration);
+		CHECK(accelStepperSteps >= expectedSteps * 0.95);
+		CHECK(coreSteps >= (expectedSteps - rampSteps) * 0.95);
+		CHECK(tableShare + sizeof(Stepper) < sizeof(AccelStepper));
+	}
+}
+
+
+int main()
+{
+	compareStepPaths();
+	return Check::finish("StepperCoreBenchmark");
+}
@@ -0,0 +1,92 @@
+#ifndef STUB_ARDUINO_H
+#define STUB_ARDUINO_H
+
+// Just enough of the Arduino core to build the firmware modules on the host. Time and the timers are simulated by
+// Simulation.cpp, digital pins are plain memory.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "avr/io.h"
+#include "avr/interrupt.h"
+#include "avr/pgmspace.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define LOW 0x0
+#define HIGH 0x1
+
+enum AnalogPin
+{
+	A0 = 54, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15
+};
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define abs(x) ((x) > 0 ? (x) : -(x))
+#define constrain(amount, low, high) ((amount) < (low) ? (low) : ((amount) > (high) ? (high) : (amount)))
+
+
+/* Pins */
+// the host has 11 ports of 8 pins, pin n is bit n % 8 of port n / 8
+const uint8_t NUMBER_OF_PORTS = 11;
+extern volatile uint8_t PORT_OUTPUTS[NUMBER_OF_PORTS + 1];
+extern volatile uint8_t PORT_INPUTS[NUMBER_OF_PORTS + 1];
+
+inline uint8_t digitalPinToPort(const uint8_t pin)
+{
+	return pin / 8 < NUMBER_OF_PORTS ? pin / 8 : NUMBER_OF_PORTS;
+}
+
+inline uint8_t digitalPinToBitMask(const uint8_t pin)
+{
+	return 1 << (pin % 8);
+}
+
+inline volatile uint8_t *portOutputRegister(const uint8_t port)
+{
+	return &PORT_OUTPUTS[port];
+}
+
+inline volatile uint8_t *portInputRegister(const uint8_t port)
+{
+	return &PORT_INPUTS[port];
+}
+
+void pinMode(const uint8_t pin, const uint8_t mode);
+int digitalRead(const uint8_t pin);
+void digitalWrite(const uint8_t pin, const uint8_t value);
+int analogRead(const uint8_t pin);
+
+
+/* Time */
+unsigned long millis();
+unsigned long micros();
+void delayMicroseconds(const unsigned int microseconds);
+
+
+/* Serial */
+class __FlashStringHelper;
+#define F(string) (reinterpret_cast<const __FlashStringHelper *>(string))
+
+class HardwareSerial
+{
+public:
+	void begin(const unsigned long) {}
+	int available() { return 0; }
+	int read() { return -1; }
+	template<typename T> void print(const T &) {}
+	template<typename T> void print(const T &, const int) {}
+	template<typename T> void println(const T &) {}
+	template<typename T> void println(const T &, const int) {}
+	void println() {}
+};
+
+extern HardwareSerial Serial;
+
+#endif // STUB_ARDUINO_H
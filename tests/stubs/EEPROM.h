@@ -0,0 +1,39 @@
+#ifndef STUB_EEPROM_H
+#define STUB_EEPROM_H
+
+#include <stdint.h>
+#include <string.h>
+
+// The 4 KB EEPROM of the ATmega2560 as a RAM array.
+class EEPROMClass
+{
+public:
+	uint8_t memory[4096];
+
+	uint8_t read(const int address) const { return memory[address]; }
+	void write(const int address, const uint8_t value) { memory[address] = value; }
+	void update(const int address, const uint8_t value) { memory[address] = value; }
+	uint16_t length() const { return sizeof(memory); }
+
+	template<typename T> T &get(const int address, T &value) const
+	{
+		memcpy(&value, &memory[address], sizeof(T));
+		return value;
+	}
+
+	template<typename T> const T &put(const int address, const T &value)
+	{
+		memcpy(&memory[address], &value, sizeof(T));
+		return value;
+	}
+};
+
+extern EEPROMClass EEPROM;
+
+// from avr/eeprom.h, which the EEPROM library includes. The array is written at once, the next write never waits
+inline bool eeprom_is_ready()
+{
+	return true;
+}
+
+#endif // STUB_EEPROM_H
@@ -0,0 +1,409 @@
+#include <signal.h>
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "Simulation.h"
+
+
+/* Registers */
+StatusRegister SREG;
+volatile uint8_t TCCR1A, TCCR1B, TCCR1C, TIMSK1, TIFR1;
+volatile uint8_t TCCR3A, TCCR3B, TCCR3C, TIMSK3, TIFR3;
+volatile uint8_t TCCR4A, TCCR4B, TCCR4C, TIMSK4, TIFR4;
+volatile uint8_t TCCR5A, TCCR5B, TCCR5C, TIMSK5, TIFR5;
+volatile uint16_t TCNT1, TCNT3, TCNT4, TCNT5;
+volatile uint16_t OCR1[3], OCR3[3], OCR4[3], OCR5[3];
+volatile uint8_t PORT_OUTPUTS[NUMBER_OF_PORTS + 1];
+volatile uint8_t PORT_INPUTS[NUMBER_OF_PORTS + 1];
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+
+
+namespace
+{
+	struct Timer
+	{
+		volatile uint8_t *controlRegisterA;
+		volatile uint8_t *controlRegisterB;
+		volatile uint8_t *forceRegister;
+		volatile uint8_t *interruptMaskRegister;
+		volatile uint8_t *interruptFlagRegister;
+		volatile uint16_t *counterRegister;
+		volatile uint16_t *compareRegisters;
+	};
+
+	const Timer TIMERS[4] =
+	{
+		{ &TCCR1A, &TCCR1B, &TCCR1C, &TIMSK1, &TIFR1, &TCNT1, OCR1 },
+		{ &TCCR3A, &TCCR3B, &TCCR3C, &TIMSK3, &TIFR3, &TCNT3, OCR3 },
+		{ &TCCR4A, &TCCR4B, &TCCR4C, &TIMSK4, &TIFR4, &TCNT4, OCR4 },
+		{ &TCCR5A, &TCCR5B, &TCCR5C, &TIMSK5, &TIFR5, &TCNT5, OCR5 }
+	};
+
+	const uint8_t INTERRUPT_ENABLE = 0x80; // the I bit of SREG
+
+	InterruptHandler handlers[NUMBER_OF_INTERRUPT_VECTORS];
+	volatile uint8_t status = INTERRUPT_ENABLE;
+	volatile uint16_t pendingInterrupts = 0;
+	unsigned long ticks = 0;
+	uint8_t levels[12];
+	int analogValues[16];
+	int preemptionSignal = 0;
+	Simulation::EdgeListener edgeListener = nullptr;
+
+
+	void blockPreemption(const boolean isBlocked)
+	{
+		if(preemptionSignal == 0)
+		{
+			return;
+		}
+
+		sigset_t signals;
+		sigemptyset(&signals);
+		sigaddset(&signals, preemptionSignal);
+		sigprocmask(isBlocked ? SIG_BLOCK : SIG_UNBLOCK, &signals, nullptr);
+	}
+
+
+	void setLevel(const uint8_t hardwareChannel, const uint8_t level)
+	{
+		if(levels[hardwareChannel] == level)
+		{
+			return;
+		}
+
+		levels[hardwareChannel] = level;
+
+		if(edgeListener != nullptr)
+		{
+			edgeListener(hardwareChannel, level, ticks);
+		}
+	}
+
+
+	// the compare output mode of a channel: 1 = toggle, 2 = clear, 3 = set
+	void applyCompareOutput(const Timer &timer, const uint8_t channel)
+	{
+		const uint8_t hardwareChannel = (&timer - TIMERS) * 3 + channel;
+		const uint8_t mode = (*timer.controlRegisterA >> (6 - 2 * channel)) & 3;
+
+		if(mode == 1)
+		{
+			setLevel(hardwareChannel, !levels[hardwareChannel]);
+		}
+		else if(mode == 2)
+		{
+			setLevel(hardwareChannel, LOW);
+		}
+		else if(mode == 3)
+		{
+			setLevel(hardwareChannel, HIGH);
+		}
+	}
+
+
+	// the registers are plain variables, so writes with side effects are applied at the next point the firmware
+	// hands control back: cli(), a write to SREG or the end of an interrupt. The firmware writes them in locked
+	// sections only, so they take effect before anything else happens
+	void synchronizeRegisters()
+	{
+		for(const Timer &timer : TIMERS)
+		{
+			// a forced compare is a strobe, it applies the output mode without a match
+			for(uint8_t channel = 0; channel < 3; channel++)
+			{
+				if(*timer.forceRegister & (_BV(FOC1A) >> channel))
+				{
+					*timer.forceRegister &= ~(_BV(FOC1A) >> channel);
+					applyCompareOutput(timer, channel);
+				}
+			}
+
+			// time only passes while interrupts are enabled, so every flag is taken by its interrupt at once. A flag
+			// register only holds the ones the firmware writes to clear them
+			*timer.interruptFlagRegister = 0;
+		}
+	}
+
+
+	void tick(const Timer &timer, const uint8_t timerIndex)
+	{
+		// only prescaler 8 is simulated, a timer with another clock stands still
+		if((*timer.controlRegisterB & 7) != _BV(CS11))
+		{
+			return;
+		}
+
+		*timer.counterRegister = *timer.counterRegister + 1;
+
+		if(timerIndex == 0 && *timer.counterRegister == 0 && (*timer.interruptMaskRegister & _BV(TOIE1)))
+		{
+			Simulation::raiseInterrupt(TIMER1_OVF_vect_number);
+		}
+
+		for(uint8_t channel = 0; channel < 3; channel++)
+		{
+			if(*timer.counterRegister != timer.compareRegisters[channel])
+			{
+				continue;
+			}
+
+			applyCompareOutput(timer, channel);
+
+			if(*timer.interruptMaskRegister & (_BV(OCIE1A) << channel))
+			{
+				Simulation::raiseInterrupt(static_cast<InterruptVector>(TIMER1_COMPA_vect_number + timerIndex * 3 +
+				                                                        channel));
+			}
+		}
+	}
+}
+
+
+StatusRegister::operator uint8_t() const
+{
+	return status;
+}
+
+
+StatusRegister &StatusRegister::operator=(const uint8_t value)
+{
+	status = value;
+	synchronizeRegisters();
+
+	if(value & INTERRUPT_ENABLE)
+	{
+		blockPreemption(false);
+		Simulation::deliverPendingInterrupts();
+	}
+	else
+	{
+		blockPreemption(true);
+	}
+
+	return *this;
+}
+
+
+void cli()
+{
+	blockPreemption(true);
+	status &= ~INTERRUPT_ENABLE;
+	synchronizeRegisters();
+}
+
+
+void sei()
+{
+	SREG = status | INTERRUPT_ENABLE;
+}
+
+
+InterruptRegistration::InterruptRegistration(const InterruptVector vector, const InterruptHandler handler)
+{
+	handlers[vector] = handler;
+}
+
+
+/**
+ * \brief Clears the registers, the pins and the time. The interrupt handlers stay registered.
+ */
+void Simulation::reset()
+{
+	for(const Timer &timer : TIMERS)
+	{
+		*timer.controlRegisterA = 0;
+		*timer.controlRegisterB = 0;
+		*timer.forceRegister = 0;
+		*timer.interruptMaskRegister = 0;
+		*timer.interruptFlagRegister = 0;
+		*timer.counterRegister = 0;
+
+		for(uint8_t channel = 0; channel < 3; channel++)
+		{
+			timer.compareRegisters[channel] = 0;
+		}
+	}
+
+	memset(levels, 0, sizeof(levels));
+	memset(const_cast<uint8_t *>(PORT_OUTPUTS), 0, sizeof(PORT_OUTPUTS));
+	memset(const_cast<uint8_t *>(PORT_INPUTS), 0, sizeof(PORT_INPUTS));
+	memset(EEPROM.memory, 0xFF, sizeof(EEPROM.memory));
+
+	for(int &value : analogValues)
+	{
+		value = 512;
+	}
+
+	status = INTERRUPT_ENABLE;
+	pendingInterrupts = 0;
+	ticks = 0;
+	edgeListener = nullptr;
+}
+
+
+/**
+ * \brief Lets the time pass tick by tick. Compare matches and overflows raise their interrupts at the tick they
+ *        happen.
+ * \param numberOfTicks	Ticks of 0.5 microseconds.
+ */
+void Simulation::advance(const unsigned long numberOfTicks)
+{
+	synchronizeRegisters();
+
+	for(unsigned long i = 0; i < numberOfTicks; i++)
+	{
+		ticks++;
+
+		for(uint8_t timerIndex = 0; timerIndex < 4; timerIndex++)
+		{
+			tick(TIMERS[timerIndex], timerIndex);
+		}
+	}
+}
+
+
+/**
+ * \brief Lets whole timer periods pass at once, for tests that need hours of runtime. The counters end where they
+ *        started and only the overflow of Timer1 is raised, so no output compare channel may be running.
+ * \param periods	Periods of 65536 ticks.
+ */
+void Simulation::skip(const unsigned long periods)
+{
+	synchronizeRegisters();
+
+	for(unsigned long i = 0; i < periods; i++)
+	{
+		ticks += 0x10000UL;
+
+		if((TCCR1B & 7) == _BV(CS11) && (TIMSK1 & _BV(TOIE1)))
+		{
+			raiseInterrupt(TIMER1_OVF_vect_number);
+		}
+	}
+}
+
+
+unsigned long Simulation::getTicks()
+{
+	return ticks;
+}
+
+
+/**
+ * \brief The level of an output compare pin.
+ * \param hardwareChannel	Channels A, B and C of Timer1, 3, 4 and 5 in this order.
+ * \return HIGH or LOW
+ */
+uint8_t Simulation::getOutputCompareLevel(const uint8_t hardwareChannel)
+{
+	return levels[hardwareChannel];
+}
+
+
+void Simulation::setEdgeListener(const EdgeListener listener)
+{
+	edgeListener = listener;
+}
+
+
+/**
+ * \brief Calls the handler of an interrupt if interrupts are enabled, otherwise it stays pending until they are.
+ *        The handler runs with the I bit cleared like on the chip.
+ * \param vector	The interrupt.
+ */
+void Simulation::raiseInterrupt(const InterruptVector vector)
+{
+	if(!(status & INTERRUPT_ENABLE))
+	{
+		pendingInterrupts |= 1 << vector;
+		return;
+	}
+
+	if(handlers[vector] == nullptr)
+	{
+		return;
+	}
+
+	status &= ~INTERRUPT_ENABLE;
+	handlers[vector]();
+	synchronizeRegisters();
+	status |= INTERRUPT_ENABLE;
+}
+
+
+void Simulation::deliverPendingInterrupts()
+{
+	for(uint8_t vector = 0; vector < NUMBER_OF_INTERRUPT_VECTORS && pendingInterrupts != 0; vector++)
+	{
+		if(pendingInterrupts & (1 << vector))
+		{
+			pendingInterrupts &= ~(1 << vector);
+			raiseInterrupt(static_cast<InterruptVector>(vector));
+		}
+	}
+}
+
+
+/**
+ * \brief Lets cli() block a signal whose handler raises interrupts, so the handler preempts the code at random
+ *        points but never inside a locked section.
+ * \param signal	The signal number, 0 = no preemption.
+ */
+void Simulation::setPreemptionSignal(const int signal)
+{
+	preemptionSignal = signal;
+}
+
+
+void Simulation::setAnalogValue(const uint8_t pin, const int value)
+{
+	analogValues[pin - A0] = value;
+}
+
+
+void pinMode(const uint8_t, const uint8_t)
+{}
+
+
+int digitalRead(const uint8_t pin)
+{
+	return (PORT_INPUTS[digitalPinToPort(pin)] & digitalPinToBitMask(pin)) ? HIGH : LOW;
+}
+
+
+void digitalWrite(const uint8_t pin, const uint8_t value)
+{
+	if(value == LOW)
+	{
+		PORT_OUTPUTS[digitalPinToPort(pin)] &= ~digitalPinToBitMask(pin);
+	}
+	else
+	{
+		PORT_OUTPUTS[digitalPinToPort(pin)] |= digitalPinToBitMask(pin);
+	}
+}
+
+
+int analogRead(const uint8_t pin)
+{
+	return analogValues[(pin >= A0 ? pin - A0 : pin) % 16];
+}
+
+
+unsigned long millis()
+{
+	return ticks / 2000;
+}
+
+
+unsigned long micros()
+{
+	return ticks / 2;
+}
+
+
+// the code takes no time, only advance() moves the simulated time
+void delayMicroseconds(const unsigned int)
+{}
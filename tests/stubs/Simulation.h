@@ -0,0 +1,33 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "Arduino.h"
+
+
+
+/**
+ * The parts of the ATmega2560 the firmware relies on: Timer1, 3, 4 and 5 count with prescaler 8, toggle their
+ * output compare pins and raise their interrupts, and SREG gates the interrupts like the I bit. The simulated time
+ * only advances in advance(), the code in between takes no time. For preemption tests a signal can stand in for
+ * the interrupts, cli() then blocks it.
+ */
+class Simulation
+{
+public:
+	/* Types */
+	typedef void (*EdgeListener)(const uint8_t hardwareChannel, const uint8_t level, const unsigned long ticks);
+
+	/* Methods */
+	static void reset();
+	static void advance(const unsigned long ticks);
+	static void skip(const unsigned long periods);
+	static unsigned long getTicks();
+	static uint8_t getOutputCompareLevel(const uint8_t hardwareChannel);
+	static void setEdgeListener(const EdgeListener listener);
+	static void raiseInterrupt(const InterruptVector vector);
+	static void deliverPendingInterrupts();
+	static void setPreemptionSignal(const int signal);
+	static void setAnalogValue(const uint8_t pin, const int value);
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,37 @@
+#ifndef STUB_AVR_INTERRUPT_H
+#define STUB_AVR_INTERRUPT_H
+
+#include "avr/io.h"
+
+// Interrupt vectors are registered with the simulation, which calls them like the chip would.
+enum InterruptVector
+{
+	TIMER1_OVF_vect_number,
+	TIMER1_COMPA_vect_number,
+	TIMER1_COMPB_vect_number,
+	TIMER1_COMPC_vect_number,
+	TIMER3_COMPA_vect_number,
+	TIMER3_COMPB_vect_number,
+	TIMER3_COMPC_vect_number,
+	TIMER4_COMPA_vect_number,
+	TIMER4_COMPB_vect_number,
+	TIMER4_COMPC_vect_number,
+	TIMER5_COMPA_vect_number,
+	TIMER5_COMPB_vect_number,
+	TIMER5_COMPC_vect_number,
+	NUMBER_OF_INTERRUPT_VECTORS
+};
+
+typedef void (*InterruptHandler)();
+
+struct InterruptRegistration
+{
+	InterruptRegistration(const InterruptVector vector, const InterruptHandler handler);
+};
+
+#define ISR(vector) \
+	extern "C" void vector(); \
+	static InterruptRegistration vector##_registration(vector##_number, vector); \
+	extern "C" void vector()
+
+#endif // STUB_AVR_INTERRUPT_H
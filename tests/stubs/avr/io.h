@@ -0,0 +1,69 @@
+#ifndef STUB_AVR_IO_H
+#define STUB_AVR_IO_H
+
+#include <stdint.h>
+
+// Registers of the ATmega2560 that the firmware touches, as plain variables. The simulation in Simulation.cpp lets
+// the timers count and raises their interrupts.
+
+#define _BV(bit) (1 << (bit))
+
+
+/* Status register */
+class StatusRegister
+{
+public:
+	operator uint8_t() const;
+	StatusRegister &operator=(const uint8_t value);
+};
+
+extern StatusRegister SREG;
+void cli();
+void sei();
+
+
+/* Timers */
+extern volatile uint8_t TCCR1A, TCCR1B, TCCR1C, TIMSK1, TIFR1;
+extern volatile uint8_t TCCR3A, TCCR3B, TCCR3C, TIMSK3, TIFR3;
+extern volatile uint8_t TCCR4A, TCCR4B, TCCR4C, TIMSK4, TIFR4;
+extern volatile uint8_t TCCR5A, TCCR5B, TCCR5C, TIMSK5, TIFR5;
+extern volatile uint16_t TCNT1, TCNT3, TCNT4, TCNT5;
+
+// the compare registers of a timer follow each other like on the chip
+extern volatile uint16_t OCR1[3], OCR3[3], OCR4[3], OCR5[3];
+#define OCR1A OCR1[0]
+#define OCR1B OCR1[1]
+#define OCR1C OCR1[2]
+#define OCR3A OCR3[0]
+#define OCR3B OCR3[1]
+#define OCR3C OCR3[2]
+#define OCR4A OCR4[0]
+#define OCR4B OCR4[1]
+#define OCR4C OCR4[2]
+#define OCR5A OCR5[0]
+#define OCR5B OCR5[1]
+#define OCR5C OCR5[2]
+
+#define CS11 1
+#define TOV1 0
+#define TOIE1 0
+#define OCIE1A 1
+#define OCIE1B 2
+#define OCIE1C 3
+#define OCF1A 1
+#define COM1A1 7
+#define COM1A0 6
+#define COM1B1 5
+#define COM1B0 4
+#define COM1C1 3
+#define COM1C0 2
+#define FOC1A 7
+#define FOC1B 6
+#define FOC1C 5
+
+
+/* Memory */
+#define RAMEND 0x21FF
+#define E2END 0x0FFF
+
+#endif // STUB_AVR_IO_H
@@ -0,0 +1,15 @@
+#ifndef STUB_AVR_PGMSPACE_H
+#define STUB_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(string) (string)
+#define pgm_read_byte(address) (*(address))
+#define pgm_read_word(address) (*(address))
+#define pgm_read_float(address) (*(address))
+#define strcmp_P strcmp
+
+#endif // STUB_AVR_PGMSPACE_H
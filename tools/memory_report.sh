@@ -0,0 +1,128 @@
+#!/bin/sh
+# Reports the flash and RAM usage of a firmware build and fails when it exceeds the budget.
+#
+# Usage: tools/memory_report.sh [path/to/Endoskop.elf]
+#
+# The sizes are taken from the linked ELF, because the object files of a -flto build contain no code yet.
+# Symbols are attributed to their translation unit and class through the debug information.
+#
+# Environment:
+#   NM, SIZE             tools to use (default avr-nm, avr-size)
+#   RAM_BUDGET           max bytes of .data + .bss (default 6144, leaves 2 KB of the 8 KB SRAM for the stack)
+#   FLASH_BUDGET         max bytes of .text + .data (default 65536)
+
+ELF=${1:-Debug/Endoskop.ino.elf}
+NM=${NM:-avr-nm}
+SIZE=${SIZE:-avr-size}
+RAM_BUDGET=${RAM_BUDGET:-6144}
+FLASH_BUDGET=${FLASH_BUDGET:-65536}
+
+if [ ! -f "$ELF" ]; then
+	echo "ELF file not found: $ELF" >&2
+	exit 2
+fi
+
+# without the tools every size would read as 0 and pass the budget
+for TOOL in "$NM" "$SIZE"; do
+	if ! command -v "$TOOL" > /dev/null; then
+		echo "$TOOL not found, set NM and SIZE to the AVR binutils" >&2
+		exit 2
+	fi
+done
+
+section_size()
+{
+	"$SIZE" -A "$ELF" | awk -v section="$1" '$1 == section { print $2 }'
+}
+
+TEXT=$(section_size .text)
+DATA=$(section_size .data)
+BSS=$(section_size .bss)
+TEXT=${TEXT:-0}
+DATA=${DATA:-0}
+BSS=${BSS:-0}
+
+echo "== Sections =="
+printf "%-8s %8d\n" ".text" "$TEXT" ".data" "$DATA" ".bss" "$BSS"
+
+report()
+{
+	# $1 = title, $2 = symbol types, $3 = grouping (file|class)
+	echo
+	echo "== $1 =="
+	"$NM" -S --size-sort -C -l "$ELF" | awk -F '\t' -v types="$2" -v grouping="$3" '
+	function hex(value,    i, result, digit)
+	{
+		result = 0
+		value = tolower(value)
+		for(i = 1; i <= length(value); i++)
+		{
+			digit = index("0123456789abcdef", substr(value, i, 1)) - 1
+			result = result * 16 + digit
+		}
+		return result
+	}
+	{
+		split($1, fields, " ")
+		if(index(types, tolower(fields[3])) == 0)
+		{
+			next
+		}
+		name = substr($1, length(fields[1]) + length(fields[2]) + length(fields[3]) + 4)
+		if(grouping == "class")
+		{
+			key = "(free)"
+			if(match(name, /^[A-Za-z_][A-Za-z0-9_]*::/))
+			{
+				key = substr(name, 1, RLENGTH - 2)
+			}
+		}
+		else if(grouping == "file")
+		{
+			key = "(library)"
+			if(NF > 1)
+			{
+				key = $2
+				sub(/:[0-9]+$/, "", key)
+				sub(/.*[\/\\]/, "", key)
+			}
+		}
+		else
+		{
+			key = name
+		}
+		sizes[key] += hex(fields[2])
+	}
+	END {
+		for(key in sizes)
+		{
+			printf "%8d  %s\n", sizes[key], key
+		}
+	}' | sort -rn
+}
+
+report ".text per translation unit" "tw" file
+report ".text per class" "tw" class
+report ".data/.bss per translation unit" "bd" file
+report ".data/.bss per object" "bd" object
+
+RAM=$((DATA + BSS))
+FLASH=$((TEXT + DATA))
+STATUS=0
+
+echo
+echo "== Budget =="
+printf "RAM   %6d / %6d bytes\n" "$RAM" "$RAM_BUDGET"
+printf "Flash %6d / %6d bytes\n" "$FLASH" "$FLASH_BUDGET"
+
+if [ "$RAM" -gt "$RAM_BUDGET" ]; then
+	echo "RAM budget exceeded by $((RAM - RAM_BUDGET)) bytes" >&2
+	STATUS=1
+fi
+
+if [ "$FLASH" -gt "$FLASH_BUDGET" ]; then
+	echo "Flash budget exceeded by $((FLASH - FLASH_BUDGET)) bytes" >&2
+	STATUS=1
+fi
+
+exit $STATUS